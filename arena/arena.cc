@@ -0,0 +1,181 @@
+// Plays any of the games headless between agents, in bulk and on every core.
+//
+// Run from the root of the repository so the word files are found:
+//   arena --game <name> [--agents a,b] [--games n] [--seed s] [--words file] [--show]
+//
+// Games: connect_four, tictactoe, jajanken, jajanken_tbbt, hangman, wordle.
+// Agents of every game: random and scripted:<action>/<action>/...; the two
+// player board games add greedy, jajanken adds its tournament bots, hangman
+// adds frequency and wordle adds consistent.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/engine.h"
+#include "../common/word_file.h"
+#include "../connect_four/connect_four_engine.h"
+#include "../hangman/hangman_engine.h"
+#include "../jajanken/jajanken_engine.h"
+#include "../tictactoe/tictactoe_engine.h"
+#include "../wordle/wordle_engine.h"
+
+std::vector<std::string> Split(const std::string& text, const char separator) {
+  std::vector<std::string> parts;
+  std::istringstream stream(text);
+  std::string part;
+  while (std::getline(stream, part, separator)) parts.push_back(part);
+  return parts;
+}
+
+// The agents only some games have
+Engine::AgentFactory<ConnectFourGame> SpecialAgent(const ConnectFourGame&, const std::string& name) {
+  if (name == "greedy") return [](std::mt19937&) { return std::make_unique<Engine::GreedyAgent<ConnectFourGame>>(); };
+  return {};
+}
+
+Engine::AgentFactory<TicTacToeGame> SpecialAgent(const TicTacToeGame&, const std::string& name) {
+  if (name == "greedy") return [](std::mt19937&) { return std::make_unique<Engine::GreedyAgent<TicTacToeGame>>(); };
+  return {};
+}
+
+template <int N>
+Engine::AgentFactory<Jajanken::Game<N>> SpecialAgent(const Jajanken::Game<N>&, const std::string& name) {
+  for (const auto& bot : Jajanken::AllBots<N>()) {
+    if (bot.name != name) continue;
+    // Every match gets a bot seeded from the match, so --seed replays the same results
+    return [make = bot.make](std::mt19937& generator) {
+      return std::make_unique<Jajanken::BotAgent<N>>(make(generator()));
+    };
+  }
+  return {};
+}
+
+Engine::AgentFactory<HangmanGame> SpecialAgent(const HangmanGame&, const std::string& name) {
+  if (name == "frequency") return [](std::mt19937&) { return std::make_unique<LetterFrequencyAgent>(); };
+  return {};
+}
+
+Engine::AgentFactory<WordleGame> SpecialAgent(const WordleGame&, const std::string& name) {
+  if (name == "consistent") return [](std::mt19937&) { return std::make_unique<ConsistentWordAgent>(); };
+  return {};
+}
+
+/**
+ * @brief Builds the agent with the given name.
+ *
+ * @return The factory of the agent, empty if there is no such agent.
+ */
+template <typename Game>
+Engine::AgentFactory<Game> MakeAgent(const Game& game, const std::string& name) {
+  if (name == "random") return [](std::mt19937&) { return std::make_unique<Engine::RandomAgent<Game>>(); };
+  if (name.rfind("scripted:", 0) == 0) {
+    std::vector<typename Game::Action> script;
+    for (const std::string& text : Split(name.substr(9), '/')) {
+      typename Game::Action action;
+      if (!game.ParseAction(text, action)) {
+        std::cerr << "Unknown action " << text << std::endl;
+        return {};
+      }
+      script.push_back(action);
+    }
+    if (script.empty()) return {};
+    return [script](std::mt19937&) { return std::make_unique<Engine::ScriptedAgent<Game>>(script); };
+  }
+  return SpecialAgent(game, name);
+}
+
+/**
+ * @brief Plays the games and prints the results.
+ *
+ * @return True on success, false if an agent is unknown.
+ */
+template <typename Game>
+bool RunGame(const Game& game, std::vector<std::string> names, const uint64_t num_games, const uint64_t seed,
+             const bool show) {
+  if (names.empty()) names.push_back("random");
+  names.resize(Game::kNumPlayers, names.back());
+  std::vector<Engine::AgentFactory<Game>> factories;
+  for (const std::string& name : names) {
+    factories.push_back(MakeAgent(game, name));
+    if (!factories.back()) {
+      std::cerr << "Unknown agent " << name << std::endl;
+      return false;
+    }
+  }
+  if (show) {
+    // One game action by action
+    std::mt19937 generator(static_cast<uint32_t>(seed));
+    std::vector<std::unique_ptr<Engine::Agent<Game>>> agents;
+    for (const auto& factory : factories) agents.push_back(factory(generator));
+    typename Game::State state{game.Initial(generator)};
+    while (!game.IsTerminal(state)) {
+      const int player{game.CurrentPlayer(state)};
+      const typename Game::Action action{agents[player]->Act(game, state, generator)};
+      std::cout << names[player] << " (" << player << "): " << game.ActionName(action) << "\n";
+      state = game.Apply(state, action);
+    }
+    std::cout << game.Render(state) << std::endl;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const auto results = Engine::RunArena(game, factories, num_games, seed);
+  const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  std::cout << std::fixed << std::setprecision(2);
+  for (int p{0}; p < Game::kNumPlayers; ++p) {
+    std::cout << "Player " << p << " " << std::left << std::setw(12) << names[p] << std::right << " wins "
+              << std::setw(6) << 100.0 * results.wins[p] / results.games << "%  mean outcome "
+              << results.score[p] / results.games << "\n";
+  }
+  std::cout << (Game::kNumPlayers == 1 ? "Lost " : "Draws ") << 100.0 * results.draws / results.games << "%, "
+            << static_cast<double>(results.actions) / results.games << " actions per game, " << results.games
+            << " games in " << seconds << " s (" << std::setprecision(0) << results.games / seconds
+            << " games/s)" << std::endl;
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  std::string game_name, words_file;
+  std::vector<std::string> agents;
+  uint64_t num_games{100000}, seed{std::random_device{}()};
+  bool show{false};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--game") == 0 && i + 1 < argc) game_name = argv[++i];
+    else if (std::strcmp(argv[i], "--agents") == 0 && i + 1 < argc) agents = Split(argv[++i], ',');
+    else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) num_games = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--words") == 0 && i + 1 < argc) words_file = argv[++i];
+    else if (std::strcmp(argv[i], "--show") == 0) show = true;
+  }
+  bool ok{true};
+  if (game_name == "connect_four") {
+    ok = RunGame(ConnectFourGame{}, agents, num_games, seed, show);
+  } else if (game_name == "tictactoe") {
+    ok = RunGame(TicTacToeGame{}, agents, num_games, seed, show);
+  } else if (game_name == "jajanken") {
+    ok = RunGame(Jajanken::Game<3>{}, agents, num_games, seed, show);
+  } else if (game_name == "jajanken_tbbt") {
+    ok = RunGame(Jajanken::Game<5>{}, agents, num_games, seed, show);
+  } else if (game_name == "hangman" || game_name == "wordle") {
+    if (words_file.empty()) words_file = game_name == "hangman" ? "hangman/hangman_en.txt" : "wordle/wordle_vocab.txt";
+    std::vector<std::string> words{ReadWordsFromFile(words_file)};
+    if (words.empty()) {
+      std::cerr << "Could not read " << words_file << ", run from the root of the repository" << std::endl;
+      return 1;
+    }
+    if (game_name == "hangman") ok = RunGame(HangmanGame(std::move(words)), agents, num_games, seed, show);
+    else ok = RunGame(WordleGame(std::move(words)), agents, num_games, seed, show);
+  } else {
+    std::cerr << "Usage: arena --game connect_four|tictactoe|jajanken|jajanken_tbbt|hangman|wordle"
+              << " [--agents a,b] [--games n] [--seed s] [--words file] [--show]" << std::endl;
+    return 1;
+  }
+  return ok ? 0 : 1;
+}
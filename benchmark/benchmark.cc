@@ -0,0 +1,154 @@
+// Microbenchmarks of the hot routines of the games.
+//
+// Run from the root of the repository so the word files are found:
+//   benchmark [--filter text] [--samples n] [--json out.json] [--baseline old.json] [--tolerance 0.05]
+// With a baseline the program fails if any benchmark regressed.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/latency.h"
+#include "../common/random.h"
+#include "../common/word_file.h"
+#include "../connect_four/connect_four_rules.h"
+#include "../hanoi/hanoi_solver.h"
+#include "../math_problem_game/turbo_board.h"
+#include "../tictactoe/tictactoe_rules.h"
+#include "../wordle/wordle_feedback.h"
+#include "../wordle/wordle_rules.h"
+#include "microbench.h"
+
+const int kNumInputs{1024}; // Inputs are cycled so branches are not perfectly predicted.
+
+std::vector<std::vector<std::vector<Connect>>> RandomConnectFourGrids() {
+  std::vector<std::vector<std::vector<Connect>>> grids;
+  for (int n{0}; n < kNumInputs; ++n) {
+    std::vector<std::vector<Connect>> grid(rows, {cols, empty});
+    const int num_moves{GetRandomNum(0, rows * cols / 2)};
+    for (int move{0}; move < num_moves; ++move) {
+      const int col{GetRandomNum(0, cols - 1)};
+      for (int i{rows - 1}; i >= 0; --i) {
+        if (grid[i][col] == empty) {
+          grid[i][col] = move % 2 ? red : yellow;
+          break;
+        }
+      }
+    }
+    grids.push_back(grid);
+  }
+  return grids;
+}
+
+std::vector<std::vector<std::pair<Cell, Form>>> RandomTicTacToeGrids() {
+  std::vector<std::vector<std::pair<Cell, Form>>> grids;
+  for (int n{0}; n < kNumInputs; ++n) {
+    std::vector<std::pair<Cell, Form>> grid;
+    for (int cell{up_left}; cell <= down_right; ++cell)
+      grid.push_back({static_cast<Cell>(cell), static_cast<Form>(GetRandomNum(nothing, cross))});
+    grids.push_back(grid);
+  }
+  return grids;
+}
+
+int main(int argc, char* argv[]) {
+  Microbench::Options options;
+  std::string json_file, baseline_file;
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) options.filter = argv[++i];
+    else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) options.samples = std::max(3, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) json_file = argv[++i];
+    else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_file = argv[++i];
+    else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) options.tolerance = std::atof(argv[++i]);
+  }
+  // Fixed inputs, so runs are comparable
+  generator.seed(42);
+  const auto connect_four_grids = RandomConnectFourGrids();
+  const auto tictactoe_grids = RandomTicTacToeGrids();
+  const std::string hangman_file{"hangman/hangman_en.txt"}, wordle_file{"wordle/wordle_vocab.txt"};
+  const std::vector<std::string> wordle_words{ReadWordsFromFile(wordle_file)};
+  if (wordle_words.empty()) {
+    std::cerr << "Could not read " << wordle_file << ", run from the root of the repository" << std::endl;
+    return 1;
+  }
+  // Only a matrix the game already built is read, the benchmark never writes in the tree
+  Feedback::Matrix feedback;
+  std::vector<std::string> feedback_words{Feedback::ReadVocabulary(wordle_file)};
+  if (!feedback.Load(feedback_words, "wordle/wordle_feedback.bin"))
+    std::cerr << "No feedback matrix for " << wordle_file << ", its benchmark is skipped" << std::endl;
+
+  Microbench::Suite suite;
+  suite.Add("connect_four/CheckWin", [&](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i)
+      Microbench::DoNotOptimize(CheckWin(connect_four_grids[i % kNumInputs]));
+  });
+  suite.Add("tictactoe/CheckWin", [&](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i)
+      Microbench::DoNotOptimize(CheckWin(tictactoe_grids[i % kNumInputs]));
+  });
+  suite.Add("wordle/CheckColors", [&](const uint64_t iterations) {
+    const size_t n{wordle_words.size()};
+    for (uint64_t i{0}; i < iterations; ++i)
+      Microbench::DoNotOptimize(CheckColors(wordle_words[(i * 7919) % n], wordle_words[(i * 104729 + 1) % n]));
+  });
+  if (feedback.IsLoaded()) {
+    suite.Add("wordle/Feedback::Matrix::Code", [&](const uint64_t iterations) {
+      const uint64_t n{feedback.Words().size()};
+      for (uint64_t i{0}; i < iterations; ++i)
+        Microbench::DoNotOptimize(feedback.Code((i * 7919) % n, (i * 104729 + 1) % n));
+    });
+  }
+  suite.Add("hangman/RandomWordFromFile", [&](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i) Microbench::DoNotOptimize(RandomWordFromFile(hangman_file));
+  });
+  suite.Add("wordle/RandomWordFromFile", [&](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i) Microbench::DoNotOptimize(RandomWordFromFile(wordle_file));
+  });
+  suite.Add("hanoi/move 16 disks", [](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i) {
+      std::vector<unsigned> source, auxiliary, target;
+      for (unsigned disk{16}; disk > 0; --disk) source.push_back(disk);
+      uint64_t num_moves{0};
+      move(16, source, auxiliary, target,
+           [&num_moves](const std::vector<unsigned>&, const std::vector<unsigned>&, const std::vector<unsigned>&) {
+             ++num_moves;
+           });
+      Microbench::DoNotOptimize(num_moves);
+    }
+  });
+  suite.Add("math_problem_game/InitializeGrid 2024", [](const uint64_t iterations) {
+    Board board(2024);
+    std::mt19937 board_generator(42);
+    for (uint64_t i{0}; i < iterations; ++i) {
+      InitializeGrid(board, board_generator);
+      Microbench::DoNotOptimize(board.monster_col.data());
+    }
+  });
+  suite.Add("common/GetRandomNum", [](const uint64_t iterations) {
+    for (uint64_t i{0}; i < iterations; ++i) Microbench::DoNotOptimize(GetRandomNum(0, 36));
+  });
+  // The cost the --stats instrumentation adds to every timed call
+  suite.Add("common/Latency::ScopedTimer", [](const uint64_t iterations) {
+    static Latency::Metric metric{"benchmark"};
+    for (uint64_t i{0}; i < iterations; ++i) Latency::ScopedTimer timer(metric);
+  });
+
+  const std::vector<Microbench::Result> results{suite.Run(options)};
+  if (!json_file.empty() && !Microbench::WriteJson(json_file, results)) {
+    std::cerr << "Could not write " << json_file << std::endl;
+    return 1;
+  }
+  if (baseline_file.empty()) return 0;
+  const auto baseline = Microbench::ReadJson(baseline_file);
+  if (baseline.empty()) {
+    std::cerr << "Could not read the baseline " << baseline_file << std::endl;
+    return 1;
+  }
+  return Microbench::Compare(results, baseline, options.tolerance) > 0 ? 1 : 0;
+}
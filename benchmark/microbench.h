@@ -0,0 +1,187 @@
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Microbench {
+  /**
+   * @brief Keeps the compiler from optimizing away a value that is never used.
+   */
+  template<typename T>
+  inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  struct Result {
+    std::string name;
+    uint64_t iterations; // Iterations per sample.
+    int samples;
+    double median_ns;    // Median time per iteration.
+    double mad_ns;       // Median absolute deviation of the time per iteration.
+    double min_ns;
+    double ci_low_ns;    // 95% confidence interval of the median.
+    double ci_high_ns;
+  };
+
+  struct Options {
+    int samples{21};
+    std::chrono::nanoseconds sample_time{std::chrono::milliseconds(10)};
+    std::string filter;  // Only benchmarks whose name contains it are run.
+    double tolerance{0.05}; // Smallest relative slowdown reported as a regression.
+  };
+
+  /**
+   * @brief A set of named benchmarks.
+   *
+   * Every benchmark body runs the kernel the given number of times. The
+   * number of iterations per sample is calibrated so a sample takes about
+   * `sample_time`, then `samples` samples are timed. Medians are reported
+   * with a distribution-free 95% confidence interval from order statistics,
+   * so one noisy sample cannot move the result.
+   */
+  class Suite {
+   public:
+    void Add(const std::string& name, const std::function<void(uint64_t)>& body) {
+      benchmarks_.push_back({name, body});
+    }
+
+    std::vector<Result> Run(const Options& options) const {
+      std::vector<Result> results;
+      for (const auto& [name, body] : benchmarks_) {
+        if (name.find(options.filter) == std::string::npos) continue;
+        results.push_back(Measure(name, body, options));
+        Print(results.back());
+      }
+      return results;
+    }
+
+   private:
+    static double Seconds(const std::function<void(uint64_t)>& body, const uint64_t iterations) {
+      const auto start = std::chrono::steady_clock::now();
+      body(iterations);
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static Result Measure(const std::string& name, const std::function<void(uint64_t)>& body, const Options& options) {
+      // Calibration doubles as warm up
+      const double target{std::chrono::duration<double>(options.sample_time).count()};
+      uint64_t iterations{1};
+      for (double elapsed{Seconds(body, iterations)}; elapsed < target; elapsed = Seconds(body, iterations)) {
+        const double scale{elapsed > 0 ? std::min(10.0, 1.2 * target / elapsed) : 10.0};
+        iterations = std::max<uint64_t>(iterations + 1, static_cast<uint64_t>(iterations * scale));
+      }
+      std::vector<double> times(options.samples);
+      for (double& time : times) time = Seconds(body, iterations) * 1e9 / iterations;
+      std::sort(times.begin(), times.end());
+      const int n{options.samples};
+      std::vector<double> deviations(n);
+      const double median{Median(times)};
+      for (int i{0}; i < n; ++i) deviations[i] = std::abs(times[i] - median);
+      std::sort(deviations.begin(), deviations.end());
+      // The ranks around n/2 that hold the median with 95% probability
+      const double half_width{0.98 * std::sqrt(static_cast<double>(n))};
+      const int low{std::max(0, static_cast<int>(std::floor(n / 2.0 - half_width)))};
+      const int high{std::min(n - 1, static_cast<int>(std::ceil(n / 2.0 + half_width)))};
+      return {name, iterations, n, median, Median(deviations), times.front(), times[low], times[high]};
+    }
+
+    static double Median(const std::vector<double>& sorted) {
+      const size_t n{sorted.size()};
+      return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    }
+
+    static void Print(const Result& result) {
+      std::cout << result.name << ": " << result.median_ns << " ns (+/- " << result.mad_ns << ", 95% CI "
+                << result.ci_low_ns << " - " << result.ci_high_ns << ", " << result.iterations << " iterations x "
+                << result.samples << ")" << std::endl;
+    }
+
+    std::vector<std::pair<std::string, std::function<void(uint64_t)>>> benchmarks_;
+  };
+
+  /**
+   * @brief Writes the results as JSON.
+   *
+   * @return False if the file cannot be written.
+   */
+  inline bool WriteJson(const std::string& file_name, const std::vector<Result>& results) {
+    std::ofstream file(file_name);
+    if (!file.is_open()) return false;
+    file << "{\n  \"benchmarks\": [";
+    for (size_t i{0}; i < results.size(); ++i) {
+      const Result& r = results[i];
+      file << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+           << ", \"samples\": " << r.samples << ", \"median_ns\": " << r.median_ns << ", \"mad_ns\": " << r.mad_ns
+           << ", \"min_ns\": " << r.min_ns << ", \"ci_low_ns\": " << r.ci_low_ns
+           << ", \"ci_high_ns\": " << r.ci_high_ns << "}";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+  }
+
+  /**
+   * @brief Reads the results written by `WriteJson`, only the fields used to compare.
+   *
+   * @return The results by name, empty if the file cannot be read.
+   */
+  inline std::map<std::string, Result> ReadJson(const std::string& file_name) {
+    std::map<std::string, Result> results;
+    std::ifstream file(file_name);
+    std::string line;
+    const auto number = [&line](const std::string& key) {
+      const size_t at{line.find("\"" + key + "\": ")};
+      return at == std::string::npos ? 0.0 : std::stod(line.substr(at + key.size() + 4));
+    };
+    while (std::getline(file, line)) {
+      const size_t at{line.find("\"name\": \"")};
+      if (at == std::string::npos) continue;
+      Result result{};
+      result.name = line.substr(at + 9, line.find('"', at + 9) - at - 9);
+      result.median_ns = number("median_ns");
+      result.ci_low_ns = number("ci_low_ns");
+      result.ci_high_ns = number("ci_high_ns");
+      results[result.name] = result;
+    }
+    return results;
+  }
+
+  /**
+   * @brief Compares the results with a baseline.
+   *
+   * A benchmark regressed if its median grew more than the tolerance and the
+   * confidence intervals do not overlap, so noise alone is not a regression.
+   *
+   * @return The number of regressions.
+   */
+  inline int Compare(const std::vector<Result>& results, const std::map<std::string, Result>& baseline,
+                     const double tolerance) {
+    int regressions{0};
+    for (const Result& result : results) {
+      const auto old = baseline.find(result.name);
+      if (old == baseline.end()) continue;
+      const double change{result.median_ns / old->second.median_ns - 1};
+      std::string verdict{"same"};
+      if (change > tolerance && result.ci_low_ns > old->second.ci_high_ns) {
+        verdict = "REGRESSION";
+        ++regressions;
+      } else if (change < -tolerance && result.ci_high_ns < old->second.ci_low_ns) {
+        verdict = "faster";
+      }
+      std::cout << result.name << ": " << old->second.median_ns << " -> " << result.median_ns << " ns ("
+                << (change >= 0 ? "+" : "") << 100 * change << "%) " << verdict << std::endl;
+    }
+    return regressions;
+  }
+}
+
+#endif // MICROBENCH_H
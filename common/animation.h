@@ -0,0 +1,113 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "keyboard.h"
+
+namespace Animation {
+  // Cleared by `--no-animation`: every animation then jumps straight to its last frame.
+  inline bool enabled{true};
+
+  /**
+   * @brief Reads the animation related flags from the command line.
+   *
+   * @param argc The number of arguments.
+   * @param argv The arguments given to the program.
+   */
+  inline void ParseFlags(const int argc, char* argv[]) {
+    for (int i{1}; i < argc; ++i)
+      if (std::strcmp(argv[i], "--no-animation") == 0) enabled = false;
+  }
+
+  /**
+   * @brief Timer-driven render loop that draws one buffered frame per tick.
+   *
+   * Between ticks the scheduler waits on stdin instead of sleeping, so the
+   * terminal stays responsive: any keypress skips straight to the last frame.
+   */
+  class Scheduler {
+   public:
+    explicit Scheduler(const std::chrono::milliseconds tick) : tick_(tick) {}
+
+    /**
+     * @brief Plays an animation of `num_frames` frames from the current line.
+     *
+     * Frames may span several lines, each one is drawn over the previous one.
+     *
+     * @param num_frames The number of frames of the animation.
+     * @param render Callback that appends the content of the given frame to the buffer.
+     * @return True if the animation was skipped by a keypress, false otherwise.
+     */
+    bool Run(const int num_frames, const std::function<void(int, std::string&)>& render) {
+      if (num_frames <= 0) return false;
+      frame_lines_ = 0;
+      if (!enabled) {
+        Draw(num_frames - 1, render);
+        return false;
+      }
+      // Only a real terminal can skip, piped input belongs to the game
+      const bool interactive{isatty(STDIN_FILENO) == 1};
+      Keyboard::RawMode raw_mode;
+      bool skipped{false};
+      auto next_tick = std::chrono::steady_clock::now();
+      for (int frame{0}; frame < num_frames; ++frame) {
+        Draw(frame, render);
+        if (frame == num_frames - 1) break;
+        next_tick += tick_;
+        if (WaitForKey(next_tick, interactive)) {
+          Draw(num_frames - 1, render);
+          skipped = true;
+          break;
+        }
+      }
+      return skipped;
+    }
+
+   private:
+    /**
+     * @brief Renders a frame into the buffer and writes it over the current line at once.
+     */
+    void Draw(const int frame, const std::function<void(int, std::string&)>& render) {
+      // Go back to the first line of the previous frame and clear it to the end
+      buffer_.assign("\r");
+      if (frame_lines_ > 0) buffer_ += "\033[" + std::to_string(frame_lines_) + "A";
+      buffer_ += "\033[J";
+      const size_t frame_start{buffer_.size()};
+      render(frame, buffer_);
+      frame_lines_ = static_cast<int>(std::count(buffer_.begin() + frame_start, buffer_.end(), '\n'));
+      std::cout.write(buffer_.data(), buffer_.size());
+      std::cout.flush();
+    }
+
+    /**
+     * @brief Waits until the deadline, returning early if a key was pressed.
+     *
+     * @return True if a keypress arrived (and was consumed) before the deadline.
+     */
+    static bool WaitForKey(const std::chrono::steady_clock::time_point deadline, const bool interactive) {
+      const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0) return false;
+      if (!interactive) {
+        std::this_thread::sleep_for(remaining);
+        return false;
+      }
+      return Keyboard::input.Wait(remaining).code != Keyboard::none;
+    }
+
+    std::chrono::milliseconds tick_;
+    std::string buffer_;
+    int frame_lines_{0}; // Line breaks in the last frame drawn.
+  };
+}
+
+#endif // ANIMATION_H
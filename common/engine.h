@@ -0,0 +1,221 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+
+/**
+ * Headless games and the agents that play them.
+ *
+ * A game plugs in by providing a class with the following pure calls, so it
+ * can be played without a terminal, copied freely and shared between threads:
+ *
+ *   using State = ...;                  // Everything about a game in progress.
+ *   using Action = ...;                 // A move of a player.
+ *   static constexpr int kNumPlayers;
+ *   State Initial(std::mt19937& generator) const;
+ *   int CurrentPlayer(const State& state) const;
+ *   void LegalActions(const State& state, std::vector<Action>& actions) const;
+ *   State Apply(State state, const Action& action) const;
+ *   bool IsTerminal(const State& state) const;
+ *   double Outcome(const State& state, int player) const; // 1 win, 0.5 draw, 0 loss.
+ *   std::string Render(const State& state) const;
+ *   std::string ActionName(const Action& action) const;
+ *   bool ParseAction(const std::string& text, Action& action) const;
+ */
+namespace Engine {
+  /**
+   * @brief A player of a game.
+   */
+  template <typename Game>
+  class Agent {
+   public:
+    virtual ~Agent() = default;
+
+    /**
+     * @brief Chooses the action of the current player, the state is never terminal.
+     */
+    virtual typename Game::Action Act(const Game& game, const typename Game::State& state,
+                                      std::mt19937& generator) = 0;
+  };
+
+  /**
+   * @brief Builds the agent of a player for one match, agents with a state
+   *        of their own seed it from the generator of the match.
+   */
+  template <typename Game>
+  using AgentFactory = std::function<std::unique_ptr<Agent<Game>>(std::mt19937& generator)>;
+
+  /**
+   * @brief Plays any legal action with the same probability.
+   */
+  template <typename Game>
+  class RandomAgent : public Agent<Game> {
+   public:
+    typename Game::Action Act(const Game& game, const typename Game::State& state,
+                              std::mt19937& generator) override {
+      game.LegalActions(state, actions_);
+      return actions_[std::uniform_int_distribution<size_t>(0, actions_.size() - 1)(generator)];
+    }
+
+   private:
+    std::vector<typename Game::Action> actions_;
+  };
+
+  /**
+   * @brief Plays a fixed list of actions in a loop, skipping the illegal ones.
+   *
+   * If none of the actions is legal it plays the first legal action.
+   */
+  template <typename Game>
+  class ScriptedAgent : public Agent<Game> {
+   public:
+    explicit ScriptedAgent(std::vector<typename Game::Action> script) : script_(std::move(script)) {}
+
+    typename Game::Action Act(const Game& game, const typename Game::State& state, std::mt19937&) override {
+      game.LegalActions(state, actions_);
+      for (size_t tried{0}; tried < script_.size(); ++tried) {
+        const typename Game::Action& action = script_[next_++ % script_.size()];
+        for (const auto& legal : actions_)
+          if (legal == action) return action;
+      }
+      return actions_.front();
+    }
+
+   private:
+    std::vector<typename Game::Action> script_;
+    std::vector<typename Game::Action> actions_;
+    size_t next_{0};
+  };
+
+  /**
+   * @brief Looks one move ahead: wins if it can, else avoids the actions that
+   *        let the next player win at once, else plays at random.
+   */
+  template <typename Game>
+  class GreedyAgent : public Agent<Game> {
+   public:
+    typename Game::Action Act(const Game& game, const typename Game::State& state,
+                              std::mt19937& generator) override {
+      const int player{game.CurrentPlayer(state)};
+      game.LegalActions(state, actions_);
+      safe_.clear();
+      for (const auto& action : actions_) {
+        const typename Game::State next{game.Apply(state, action)};
+        if (game.IsTerminal(next)) {
+          if (game.Outcome(next, player) == 1) return action;
+        } else if (!OpponentWins(game, next, player)) {
+          safe_.push_back(action);
+        }
+      }
+      const std::vector<typename Game::Action>& choices = safe_.empty() ? actions_ : safe_;
+      return choices[std::uniform_int_distribution<size_t>(0, choices.size() - 1)(generator)];
+    }
+
+   private:
+    bool OpponentWins(const Game& game, const typename Game::State& state, const int player) {
+      if (game.CurrentPlayer(state) == player) return false;
+      game.LegalActions(state, replies_);
+      for (const auto& reply : replies_) {
+        const typename Game::State next{game.Apply(state, reply)};
+        if (game.IsTerminal(next) && game.Outcome(next, player) == 0) return true;
+      }
+      return false;
+    }
+
+    std::vector<typename Game::Action> actions_;
+    std::vector<typename Game::Action> safe_;
+    std::vector<typename Game::Action> replies_;
+  };
+
+  /**
+   * @brief Plays one game between the given agents, one per player.
+   *
+   * @return The final state.
+   */
+  template <typename Game>
+  typename Game::State Play(const Game& game, const std::vector<Agent<Game>*>& agents, std::mt19937& generator,
+                            int* num_actions = nullptr) {
+    typename Game::State state{game.Initial(generator)};
+    int actions{0};
+    for (; !game.IsTerminal(state); ++actions)
+      state = game.Apply(state, agents[game.CurrentPlayer(state)]->Act(game, state, generator));
+    if (num_actions) *num_actions = actions;
+    return state;
+  }
+
+  /**
+   * @brief The results of many games.
+   */
+  template <int kNumPlayers>
+  struct ArenaResults {
+    uint64_t games{0};
+    uint64_t actions{0};
+    uint64_t wins[kNumPlayers]{};
+    uint64_t draws{0};           // Games nobody won, in single player games the losses.
+    double score[kNumPlayers]{}; // Sum of the outcomes.
+
+    void Merge(const ArenaResults& other) {
+      games += other.games;
+      actions += other.actions;
+      draws += other.draws;
+      for (int p{0}; p < kNumPlayers; ++p) {
+        wins[p] += other.wins[p];
+        score[p] += other.score[p];
+      }
+    }
+  };
+
+  /**
+   * @brief Plays many independent games on every core.
+   *
+   * Every game gets fresh agents from the factories, so agents that learn
+   * during a game start from scratch, and its own seed, so the results
+   * do not depend on the number of threads.
+   *
+   * @param game The game.
+   * @param factories One agent factory per player.
+   * @param num_games The number of games.
+   * @param seed The seed of the first game.
+   * @return The results.
+   */
+  template <typename Game>
+  ArenaResults<Game::kNumPlayers> RunArena(const Game& game, const std::vector<AgentFactory<Game>>& factories,
+                                           const uint64_t num_games, const uint64_t seed) {
+    using Results = ArenaResults<Game::kNumPlayers>;
+    return Parallel::Accumulate<Results>(num_games, [&](Results& results, uint64_t begin, uint64_t end, unsigned) {
+      for (uint64_t n{begin}; n < end; ++n) {
+        std::mt19937 generator(static_cast<uint32_t>(seed + n));
+        std::vector<std::unique_ptr<Agent<Game>>> owned;
+        std::vector<Agent<Game>*> agents;
+        for (const auto& factory : factories) {
+          owned.push_back(factory(generator));
+          agents.push_back(owned.back().get());
+        }
+        int num_actions{0};
+        const typename Game::State state{Play(game, agents, generator, &num_actions)};
+        ++results.games;
+        results.actions += num_actions;
+        bool won{false};
+        for (int p{0}; p < Game::kNumPlayers; ++p) {
+          const double outcome{game.Outcome(state, p)};
+          results.score[p] += outcome;
+          if (outcome == 1) {
+            ++results.wins[p];
+            won = true;
+          }
+        }
+        if (!won) ++results.draws;
+      }
+    });
+  }
+}
+
+#endif // ENGINE_H
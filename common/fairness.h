@@ -0,0 +1,251 @@
+#ifndef FAIRNESS_H
+#define FAIRNESS_H
+
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "parallel.h"
+
+namespace Fairness {
+  // A test fails when its p-value is below this, low enough to never trip by chance
+  const double kFailureP{1e-6};
+  // The draws of a bare --fairness
+  const uint64_t kQuickDraws{10000000};
+
+  /**
+   * @brief Regularized upper incomplete gamma function Q(a, x).
+   *
+   * Uses the series expansion below a + 1 and Lentz's continued fraction above.
+   */
+  inline double GammaQ(const double a, const double x) {
+    if (x <= 0) return 1.0;
+    const double log_prefix{a * std::log(x) - x - std::lgamma(a)};
+    if (x < a + 1) {
+      double term{1.0 / a}, sum{term};
+      for (int n{1}; n < 10000 && std::fabs(term) > std::fabs(sum) * 1e-15; ++n) {
+        term *= x / (a + n);
+        sum += term;
+      }
+      return 1.0 - sum * std::exp(log_prefix);
+    }
+    const double tiny{1e-300};
+    double b{x + 1 - a}, c{1 / tiny}, d{1 / b}, fraction{d};
+    for (int n{1}; n < 10000; ++n) {
+      const double an{-n * (n - a)};
+      b += 2;
+      d = an * d + b;
+      if (std::fabs(d) < tiny) d = tiny;
+      c = b + an / c;
+      if (std::fabs(c) < tiny) c = tiny;
+      d = 1 / d;
+      const double delta{d * c};
+      fraction *= delta;
+      if (std::fabs(delta - 1) < 1e-15) break;
+    }
+    return std::exp(log_prefix) * fraction;
+  }
+
+  /**
+   * @brief Two-sided p-value of a standard normal statistic.
+   */
+  inline double NormalP(const double z) { return std::erfc(std::fabs(z) / std::sqrt(2.0)); }
+
+  /**
+   * @brief Streaming state of the chi-square, serial correlation and runs
+   *        tests over one sequence of outcomes, in constant memory.
+   *
+   * Every thread draws its own sequence; merging keeps the chunks apart so
+   * pairs and runs never span two independent sequences.
+   */
+  class OutcomeTests {
+   public:
+    /**
+     * @brief Prepares the tests for a new sequence.
+     *
+     * @param num_outcomes The outcomes are the integers [0, num_outcomes).
+     * @param mean The expected mean of an outcome, splits outcomes for the runs test.
+     */
+    void Reset(const int num_outcomes, const double mean) {
+      counts_.assign(num_outcomes, 0);
+      mean_ = mean;
+    }
+
+    void Add(const int outcome) {
+      ++counts_[outcome];
+      const double x{static_cast<double>(outcome)};
+      if (count_ > 0) {
+        ++pairs_;
+        sum_x_ += previous_;
+        sum_y_ += x;
+        sum_xx_ += previous_ * previous_;
+        sum_yy_ += x * x;
+        sum_xy_ += previous_ * x;
+      }
+      previous_ = x;
+      ++count_;
+      // Outcomes equal to the mean belong to neither side of the runs test
+      if (x == mean_) return;
+      const int side{x > mean_ ? 1 : -1};
+      (side > 0 ? above_ : below_) += 1;
+      if (side != last_side_) ++runs_;
+      last_side_ = side;
+    }
+
+    void Merge(const OutcomeTests& other) {
+      if (counts_.size() < other.counts_.size()) counts_.resize(other.counts_.size(), 0);
+      for (size_t i{0}; i < other.counts_.size(); ++i) counts_[i] += other.counts_[i];
+      count_ += other.count_;
+      pairs_ += other.pairs_;
+      sum_x_ += other.sum_x_;
+      sum_y_ += other.sum_y_;
+      sum_xx_ += other.sum_xx_;
+      sum_yy_ += other.sum_yy_;
+      sum_xy_ += other.sum_xy_;
+      runs_total_ += other.runs_total_ + other.runs_;
+      runs_expected_ += other.runs_expected_ + other.ChunkRunsExpected();
+      runs_variance_ += other.runs_variance_ + other.ChunkRunsVariance();
+      // Close this chunk too, later outcomes belong to a new sequence
+      runs_total_ += runs_;
+      runs_expected_ += ChunkRunsExpected();
+      runs_variance_ += ChunkRunsVariance();
+      above_ = below_ = runs_ = 0;
+      last_side_ = 0;
+    }
+
+    /**
+     * @brief Pearson's chi-square statistic against the expected probabilities.
+     *
+     * @param probabilities The expected probability of every outcome.
+     * @param dof Set to the degrees of freedom of the statistic.
+     */
+    double ChiSquare(const std::vector<double>& probabilities, int& dof) const {
+      double chi2{0};
+      dof = -1;
+      for (size_t i{0}; i < counts_.size(); ++i) {
+        const double expected{probabilities[i] * count_};
+        if (expected <= 0) {
+          // An impossible outcome that happened fails the test outright
+          if (counts_[i] > 0) return INFINITY;
+          continue;
+        }
+        const double diff{counts_[i] - expected};
+        chi2 += diff * diff / expected;
+        ++dof;
+      }
+      return chi2;
+    }
+
+    /**
+     * @brief Lag-1 serial correlation of the outcomes.
+     */
+    double SerialCorrelation() const {
+      const double n{static_cast<double>(pairs_)};
+      const double covariance{sum_xy_ - sum_x_ * sum_y_ / n};
+      const double variance{(sum_xx_ - sum_x_ * sum_x_ / n) * (sum_yy_ - sum_y_ * sum_y_ / n)};
+      return variance > 0 ? covariance / std::sqrt(variance) : 0.0;
+    }
+
+    /**
+     * @brief Wald-Wolfowitz statistic of the runs above and below the mean.
+     */
+    double RunsZ() const {
+      const double total{runs_total_ + runs_};
+      const double expected{runs_expected_ + ChunkRunsExpected()};
+      const double variance{runs_variance_ + ChunkRunsVariance()};
+      return variance > 0 ? (total - expected) / std::sqrt(variance) : 0.0;
+    }
+
+    uint64_t Count() const { return count_; }
+    uint64_t Pairs() const { return pairs_; }
+
+   private:
+    double ChunkRunsExpected() const {
+      const double n{above_ + below_};
+      return n > 0 ? 1 + 2 * above_ * below_ / n : 0.0;
+    }
+
+    double ChunkRunsVariance() const {
+      const double n{above_ + below_}, product{2 * above_ * below_};
+      return n > 1 ? product * (product - n) / (n * n * (n - 1)) : 0.0;
+    }
+
+    std::vector<uint64_t> counts_;
+    double mean_{0};
+    uint64_t count_{0};
+    // Serial correlation sums over the pairs (previous, current)
+    uint64_t pairs_{0};
+    double previous_{0};
+    double sum_x_{0}, sum_y_{0}, sum_xx_{0}, sum_yy_{0}, sum_xy_{0};
+    // Runs of the open chunk, and the totals of the closed ones
+    double above_{0}, below_{0}, runs_{0};
+    int last_side_{0};
+    double runs_total_{0}, runs_expected_{0}, runs_variance_{0};
+  };
+
+  /**
+   * @brief Draws outcomes on every core, runs the tests and prints their p-values.
+   *
+   * @param name The name of the outcome path, for the report.
+   * @param num_draws The number of outcomes to draw.
+   * @param probabilities The expected probability of every outcome.
+   * @param draw Returns a new outcome, copied once per thread.
+   * @return True if every test passed, false otherwise.
+   */
+  template <typename Draw>
+  bool Run(const std::string& name, const uint64_t num_draws, const std::vector<double>& probabilities,
+           const Draw& draw) {
+    double mean{0};
+    for (size_t i{0}; i < probabilities.size(); ++i) mean += i * probabilities[i];
+    const auto start = std::chrono::steady_clock::now();
+    const OutcomeTests tests{Parallel::Accumulate<OutcomeTests>(
+        num_draws, [&](OutcomeTests& thread_tests, uint64_t begin, uint64_t end, unsigned) {
+          Draw thread_draw{draw};
+          thread_tests.Reset(static_cast<int>(probabilities.size()), mean);
+          for (uint64_t i{begin}; i < end; ++i) thread_tests.Add(thread_draw());
+        })};
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    int dof{0};
+    const double chi2{tests.ChiSquare(probabilities, dof)};
+    const double chi2_p{std::isinf(chi2) ? 0.0 : GammaQ(dof / 2.0, chi2 / 2.0)};
+    const double serial{tests.SerialCorrelation()};
+    const double serial_p{NormalP(serial * std::sqrt(static_cast<double>(tests.Pairs())))};
+    const double runs_z{tests.RunsZ()};
+    const double runs_p{NormalP(runs_z)};
+    const bool passed{chi2_p >= kFailureP && serial_p >= kFailureP && runs_p >= kFailureP};
+    std::cout << std::setprecision(4) << name << ": " << tests.Count() << " draws in " << elapsed.count()
+              << " s (" << tests.Count() / elapsed.count() / 1e6 << " M/s)\n"
+              << "  chi-square " << chi2 << " (dof " << dof << ")  p = " << chi2_p << "\n"
+              << "  serial correlation " << serial << "  p = " << serial_p << "\n"
+              << "  runs z " << runs_z << "  p = " << runs_p << "\n"
+              << "  " << (passed ? "PASS" : "FAIL") << std::endl;
+    return passed;
+  }
+
+  /**
+   * @brief Reads the number of draws of `--fairness [draws]`.
+   *
+   * Without a count it is a quick check, a few seconds on one core, still
+   * enough draws to catch a bias of about a percent on the common outcomes.
+   * Billions of draws have to be asked for.
+   *
+   * @return The number of draws, or 0 if the flag was not given.
+   */
+  inline uint64_t ParseFlag(const int argc, char* argv[]) {
+    for (int i{1}; i < argc; ++i) {
+      if (std::string(argv[i]) != "--fairness") continue;
+      if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+        return std::strtoull(argv[i + 1], nullptr, 10);
+      return kQuickDraws;
+    }
+    return 0;
+  }
+}
+
+#endif // FAIRNESS_H
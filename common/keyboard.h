@@ -0,0 +1,182 @@
+#ifndef KEYBOARD_H
+#define KEYBOARD_H
+
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include "terminal.h"
+
+namespace Keyboard {
+  enum Code {
+    none, // No key arrived before the timeout.
+    character,
+    enter,
+    backspace,
+    escape,
+    up,
+    down,
+    left,
+    right,
+    end_of_input
+  };
+
+  struct Key {
+    Code code;
+    char ch; // The character typed, only for `character`.
+  };
+
+  /**
+   * @brief Puts the terminal in raw mode while alive: no line buffering and no echo.
+   *
+   * Signals (Ctrl-C) still work. Nothing is changed if stdin is not a terminal.
+   */
+  class RawMode {
+   public:
+    RawMode() : active_(isatty(STDIN_FILENO) == 1 && tcgetattr(STDIN_FILENO, &old_mode_) == 0) {
+      if (!active_) return;
+      termios raw_mode{old_mode_};
+      raw_mode.c_lflag &= ~(ICANON | ECHO);
+      raw_mode.c_cc[VMIN] = 0;
+      raw_mode.c_cc[VTIME] = 0;
+      tcsetattr(STDIN_FILENO, TCSANOW, &raw_mode);
+    }
+
+    RawMode(const RawMode&) = delete;
+    RawMode& operator=(const RawMode&) = delete;
+
+    ~RawMode() {
+      if (active_) tcsetattr(STDIN_FILENO, TCSANOW, &old_mode_);
+    }
+
+   private:
+    bool active_;
+    termios old_mode_{};
+  };
+
+  /**
+   * @brief Reads keypresses from stdin, decoding the arrow escape sequences.
+   *
+   * Waits use `poll`, so the caller gets control back on every tick and can
+   * animate or think while the player decides.
+   */
+  class Reader {
+   public:
+    /**
+     * @brief Waits for a key until the timeout.
+     *
+     * @param timeout How long to wait, a negative value waits forever.
+     * @return The key, `none` on timeout.
+     */
+    Key Wait(const std::chrono::milliseconds timeout) {
+      // What was drawn must be visible before blocking
+      Console::frame.Flush();
+      std::cout.flush();
+      if (begin_ == end_ && !Fill(static_cast<int>(timeout.count()))) return {none, 0};
+      if (begin_ == end_) return {end_of_input, 0};
+      const char first{buffer_[begin_++]};
+      switch (first) {
+        case '\n':
+        case '\r':
+          return {enter, 0};
+        case 127:
+        case '\b':
+          return {backspace, 0};
+        case '\033':
+          return DecodeEscape();
+      }
+      return {character, first};
+    }
+
+    /**
+     * @brief Waits for a key, calling `on_tick` every `tick` until it arrives.
+     *
+     * @param on_tick Work to do while waiting, may be empty.
+     * @param tick The time between calls to `on_tick`.
+     * @return The key, never `none`.
+     */
+    Key Read(const std::function<void()>& on_tick = {},
+             const std::chrono::milliseconds tick = std::chrono::milliseconds(100)) {
+      RawMode raw_mode;
+      while (true) {
+        const Key key{Wait(on_tick ? tick : std::chrono::milliseconds(-1))};
+        if (key.code != none) return key;
+        on_tick();
+      }
+    }
+
+    /**
+     * @brief Reads a line, echoing it and handling backspace.
+     *
+     * @param line The line read, without the line break.
+     * @return False if the input ended before any character was typed.
+     */
+    bool ReadLine(std::string& line) {
+      RawMode raw_mode;
+      line.clear();
+      while (true) {
+        const Key key{Wait(std::chrono::milliseconds(-1))};
+        if (key.code == end_of_input) return !line.empty();
+        if (key.code == enter) break;
+        if (key.code == backspace && !line.empty()) {
+          line.pop_back();
+          std::cout << "\b \b";
+        } else if (key.code == character && static_cast<unsigned char>(key.ch) >= ' ') {
+          line += key.ch;
+          std::cout << key.ch;
+        }
+      }
+      std::cout << std::endl;
+      return true;
+    }
+
+   private:
+    /**
+     * @brief Waits for input and appends it to the buffer.
+     *
+     * @return False on timeout. At the end of the input it returns true with an empty buffer.
+     */
+    bool Fill(const int timeout_ms) {
+      pollfd input{STDIN_FILENO, POLLIN, 0};
+      if (poll(&input, 1, timeout_ms) <= 0) return false;
+      begin_ = 0;
+      const ssize_t count{read(STDIN_FILENO, buffer_, sizeof(buffer_))};
+      end_ = count > 0 ? static_cast<size_t>(count) : 0;
+      return true;
+    }
+
+    /**
+     * @brief Decodes the rest of an escape sequence, a lone escape is the Esc key.
+     */
+    Key DecodeEscape() {
+      // The rest of the sequence arrives right after the escape
+      if (begin_ == end_ && !Fill(kSequenceTimeoutMs)) return {escape, 0};
+      if (begin_ + 1 >= end_ || (buffer_[begin_] != '[' && buffer_[begin_] != 'O')) return {escape, 0};
+      const char final_byte{buffer_[begin_ + 1]};
+      begin_ += 2;
+      switch (final_byte) {
+        case 'A': return {up, 0};
+        case 'B': return {down, 0};
+        case 'C': return {right, 0};
+        case 'D': return {left, 0};
+      }
+      return {escape, 0};
+    }
+
+    static constexpr int kSequenceTimeoutMs{20};
+    char buffer_[64];
+    size_t begin_{0};
+    size_t end_{0};
+  };
+
+  // The stdin reader shared by the whole program, so no buffered key is lost.
+  inline Reader input;
+}
+
+#endif // KEYBOARD_H
@@ -0,0 +1,221 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Always-on latency instrumentation.
+ *
+ * A `Metric` is a named histogram of durations. Every thread records into its
+ * own shard with plain relaxed stores, so recording takes no lock and no
+ * atomic read-modify-write; the shards are only merged when read. A scoped
+ * timer costs two clock reads and one store, cheap enough to leave on.
+ */
+namespace Latency {
+  /**
+   * @brief A log-linear (HDR) histogram of nanoseconds.
+   *
+   * Values below 256 have their own bucket, above that each power of 2 is
+   * split in 128 buckets, so a value is known within 1% up to about an hour.
+   */
+  class Histogram {
+   public:
+    static constexpr int kSubBits{7};
+    static constexpr int kSubBuckets{1 << kSubBits};
+    static constexpr int kMaxShift{35};
+    static constexpr int kNumBuckets{kSubBuckets * (kMaxShift + 2)};
+
+    static int Bucket(uint64_t value) {
+      const uint64_t max_value{((2ULL * kSubBuckets) << kMaxShift) - 1};
+      value = std::min(value, max_value);
+      if (value < 2 * kSubBuckets) return static_cast<int>(value);
+      const int shift{63 - __builtin_clzll(value) - kSubBits};
+      return kSubBuckets * shift + static_cast<int>(value >> shift);
+    }
+
+    // The middle of the values that fall in a bucket
+    static uint64_t Value(const int bucket) {
+      if (bucket < 2 * kSubBuckets) return bucket;
+      const int shift{bucket / kSubBuckets - 1};
+      const uint64_t low{static_cast<uint64_t>(bucket - kSubBuckets * shift) << shift};
+      return low + (1ULL << shift) / 2;
+    }
+
+    /**
+     * @brief Adds a value, only ever called by the thread owning the histogram.
+     */
+    void Record(const uint64_t nanoseconds) {
+      std::atomic<uint64_t>& count{counts_[Bucket(nanoseconds)]};
+      count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void MergeInto(std::vector<uint64_t>& totals) const {
+      totals.resize(kNumBuckets);
+      for (int b{0}; b < kNumBuckets; ++b) totals[b] += counts_[b].load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::array<std::atomic<uint64_t>, kNumBuckets> counts_{};
+  };
+
+  /**
+   * @brief Count and percentiles of merged bucket counts.
+   */
+  struct Summary {
+    uint64_t count{0};
+    uint64_t p50{0}, p99{0}, p999{0}, max{0};
+  };
+
+  inline Summary Summarize(const std::vector<uint64_t>& counts) {
+    Summary summary;
+    for (const uint64_t count : counts) summary.count += count;
+    if (summary.count == 0) return summary;
+    const double quantiles[]{0.5, 0.99, 0.999};
+    uint64_t* results[]{&summary.p50, &summary.p99, &summary.p999};
+    uint64_t seen{0};
+    int next{0};
+    for (int b{0}; b < static_cast<int>(counts.size()); ++b) {
+      if (counts[b] == 0) continue;
+      seen += counts[b];
+      while (next < 3 && seen >= quantiles[next] * summary.count) *results[next++] = Histogram::Value(b);
+      summary.max = Histogram::Value(b);
+    }
+    return summary;
+  }
+
+  class Metric;
+
+  // Every metric, in the order they were created
+  inline std::vector<Metric*>& Metrics() {
+    static std::vector<Metric*> metrics;
+    return metrics;
+  }
+
+  /**
+   * @brief A named latency, recorded by any thread.
+   *
+   * Metrics are meant to be globals, they must outlive the threads using them.
+   */
+  class Metric {
+   public:
+    explicit Metric(std::string name) : name_(std::move(name)), id_(Metrics().size()) { Metrics().push_back(this); }
+
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    void Record(const uint64_t nanoseconds) { Shard().Record(nanoseconds); }
+
+    const std::string& Name() const { return name_; }
+
+    /**
+     * @brief Merges the shards of every thread.
+     */
+    Summary Read() const {
+      std::vector<uint64_t> counts(Histogram::kNumBuckets);
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& shard : shards_) shard->MergeInto(counts);
+      return Summarize(counts);
+    }
+
+   private:
+    Histogram& Shard() {
+      // Indexed by metric, the shards of the calling thread
+      thread_local std::vector<Histogram*> shards;
+      if (id_ < shards.size() && shards[id_]) return *shards[id_];
+      if (id_ >= shards.size()) shards.resize(id_ + 1, nullptr);
+      std::lock_guard<std::mutex> lock(mutex_);
+      shards_.push_back(std::make_unique<Histogram>());
+      return *(shards[id_] = shards_.back().get());
+    }
+
+    std::string name_;
+    size_t id_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Histogram>> shards_;
+  };
+
+  /**
+   * @brief Records the time from its construction to its destruction.
+   */
+  class ScopedTimer {
+   public:
+    explicit ScopedTimer(Metric& metric) : metric_(metric), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+      const auto elapsed = std::chrono::steady_clock::now() - start_;
+      metric_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+   private:
+    Metric& metric_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  /**
+   * @brief Runs a function and records how long it took.
+   *
+   * @return What the function returns.
+   */
+  template <typename Function>
+  auto Time(Metric& metric, Function&& function) {
+    ScopedTimer timer(metric);
+    return function();
+  }
+
+  inline std::string Format(const uint64_t nanoseconds) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1);
+    if (nanoseconds < 1000) text << nanoseconds << " ns";
+    else if (nanoseconds < 1000000) text << nanoseconds / 1e3 << " us";
+    else if (nanoseconds < 1000000000) text << nanoseconds / 1e6 << " ms";
+    else text << nanoseconds / 1e9 << " s";
+    return text.str();
+  }
+
+  /**
+   * @brief Prints a line of percentiles for every metric that was recorded.
+   */
+  inline void Print(std::ostream& out) {
+    out << std::left << std::setw(16) << "latency" << std::right << std::setw(10) << "count" << std::setw(12) << "p50"
+        << std::setw(12) << "p99" << std::setw(12) << "p999" << std::setw(12) << "max" << "\n";
+    for (const Metric* metric : Metrics()) {
+      const Summary summary{metric->Read()};
+      if (summary.count == 0) continue;
+      out << std::left << std::setw(16) << metric->Name() << std::right << std::setw(10) << summary.count
+          << std::setw(12) << Format(summary.p50) << std::setw(12) << Format(summary.p99) << std::setw(12)
+          << Format(summary.p999) << std::setw(12) << Format(summary.max) << "\n";
+    }
+    out << std::flush;
+  }
+
+  /**
+   * @brief Prints the latencies on exit if `--stats` is given.
+   *
+   * @return True if the flag was given.
+   */
+  inline bool ParseFlag(const int argc, char* argv[]) {
+    for (int i{1}; i < argc; ++i) {
+      if (std::string(argv[i]) != "--stats") continue;
+      std::atexit([] { Print(std::cerr); });
+      return true;
+    }
+    return false;
+  }
+}
+
+#endif // LATENCY_H
@@ -0,0 +1,42 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace Parallel {
+  /**
+   * @brief The number of threads worth running on this machine.
+   */
+  inline unsigned NumThreads() {
+    const unsigned hardware{std::thread::hardware_concurrency()};
+    return hardware == 0 ? 1 : hardware;
+  }
+
+  /**
+   * @brief Splits the work items [0, count) in one contiguous chunk per thread.
+   *
+   * Every thread fills its own accumulator, so nothing is shared while the
+   * work runs, and the accumulators are merged in thread order at the end.
+   *
+   * @param count The number of work items.
+   * @param work Called as work(accumulator, begin, end, thread) for every chunk.
+   * @param num_threads The number of threads to use.
+   * @return The merge of every accumulator, `Accumulator` must provide Merge().
+   */
+  template <typename Accumulator, typename Work>
+  Accumulator Accumulate(const uint64_t count, const Work& work, const unsigned num_threads = NumThreads()) {
+    std::vector<Accumulator> partial(num_threads);
+    std::vector<std::thread> threads;
+    for (unsigned t{0}; t < num_threads; ++t) {
+      const uint64_t begin{count * t / num_threads}, end{count * (t + 1) / num_threads};
+      threads.emplace_back([&work, &partial, t, begin, end] { work(partial[t], begin, end, t); });
+    }
+    for (auto& thread : threads) thread.join();
+    for (unsigned t{1}; t < num_threads; ++t) partial[0].Merge(partial[t]);
+    return partial[0];
+  }
+}
+
+#endif // PARALLEL_H
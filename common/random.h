@@ -1,10 +1,10 @@
-#include <random>
+#ifndef RANDOM_H
+#define RANDOM_H
 
-#ifndef RANDOM_INT_GEN_H
-#define RANDOM_INT_GEN_H
+#include <random>
 
-// Initialize the random generator once
-std::mt19937 generator(std::random_device{}());
+// Initialize the random generator once per thread
+inline thread_local std::mt19937 generator(std::random_device{}());
 
 /**
  * @brief Generate a random integer between min and max (inclusive).
@@ -13,9 +13,9 @@ std::mt19937 generator(std::random_device{}());
  * @param max The maximum value of the random number.
  * @return A random integer between min and max.
  */
-int GetRandomNum(const int min, const int max) {
+inline int GetRandomNum(const int min, const int max) {
   std::uniform_int_distribution<int> distribution(min, max);
   return distribution(generator);
 }
 
-#endif // RANDOM_INT_GEN_H
\ No newline at end of file
+#endif // RANDOM_H
@@ -0,0 +1,433 @@
+#ifndef STATS_STORE_H
+#define STATS_STORE_H
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Persistent results of every game, shared by all the programs.
+ *
+ * Two files live next to each other:
+ * - `<prefix>.log`: an append-only log of fixed size records, one per game.
+ * - `<prefix>.idx`: a hash table of the totals of every player, memory mapped
+ *   and updated in place after each append.
+ * The index remembers how many log records it holds, so opening the store
+ * only replays the records appended since (none unless a process died between
+ * the append and the update). Queries read the mapping, never the log.
+ * Compaction folds the log into one record per player, game and outcome.
+ */
+namespace Stats {
+  enum class Game : uint16_t { jajanken, jajanken_tbbt, hangman, wordle, connect_four, count };
+  enum class Outcome : int16_t { loss = -1, draw = 0, win = 1 };
+
+  const int kNumGames{static_cast<int>(Game::count)};
+  const char* const kGameNames[kNumGames]{"jajanken", "jajanken_tbbt", "hangman", "wordle", "connect_four"};
+  const size_t kMaxName{15};
+  // The log is compacted once it is this long and mostly made of single games
+  const uint64_t kCompactAt{1 << 20};
+
+  struct Record {
+    int64_t time;             // Seconds since the epoch, of the last game counted.
+    char player[kMaxName + 1];
+    Game game;
+    Outcome outcome;
+    uint32_t count;           // Games counted, more than 1 after a compaction.
+  };
+  static_assert(sizeof(Record) == 32, "log records have a fixed size");
+
+  struct Totals {
+    uint32_t wins{0}, losses{0}, draws{0};
+
+    uint32_t Games() const { return wins + losses + draws; }
+  };
+
+  struct Standing {
+    std::string player;
+    Totals totals;
+  };
+
+  /**
+   * @brief The prefix of the store files, `$CPP_GAMES_STATS` or `~/.cpp_games_stats`.
+   */
+  inline std::string DefaultPrefix() {
+    if (const char* prefix{std::getenv("CPP_GAMES_STATS")}) return prefix;
+    const char* home{std::getenv("HOME")};
+    return std::string(home ? home : ".") + "/.cpp_games_stats";
+  }
+
+  /**
+   * @brief The name results are recorded under, `$USER` or "player".
+   */
+  inline std::string CurrentPlayer() {
+    const char* user{std::getenv("USER")};
+    return std::string(user && *user ? user : "player").substr(0, kMaxName);
+  }
+
+  class Store {
+   public:
+    explicit Store(const std::string& prefix = DefaultPrefix()) : log_path_(prefix + ".log") {
+      log_fd_ = open(log_path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+      index_fd_ = open((prefix + ".idx").c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (log_fd_ < 0 || index_fd_ < 0) return;
+      Lock lock(index_fd_, LOCK_EX);
+      open_ = Load();
+    }
+
+    Store(const Store&) = delete;
+    Store& operator=(const Store&) = delete;
+
+    ~Store() {
+      if (header_) munmap(header_, mapped_size_);
+      if (log_fd_ >= 0) close(log_fd_);
+      if (index_fd_ >= 0) close(index_fd_);
+    }
+
+    bool IsOpen() const { return open_; }
+
+    /**
+     * @brief Appends the result of a game and adds it to the player's totals.
+     *
+     * @return True on success, false if the store could not be written.
+     */
+    bool Add(const std::string& player, const Game game, const Outcome outcome) {
+      if (!open_) return false;
+      Record record{};
+      record.time = std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count();
+      std::strncpy(record.player, player.c_str(), kMaxName);
+      record.game = game;
+      record.outcome = outcome;
+      record.count = 1;
+      Lock lock(index_fd_, LOCK_EX);
+      if (!Refresh()) return false;
+      if (write(log_fd_, &record, sizeof(record)) != sizeof(record)) return false;
+      if (!Apply(record)) return false;
+      ++header_->log_records;
+      if (header_->log_records >= kCompactAt && header_->log_records > 4 * kNumGames * 3 * header_->num_players)
+        return CompactLocked();
+      return true;
+    }
+
+    /**
+     * @brief The totals of a player in a game.
+     */
+    Totals Get(const std::string& player, const Game game) {
+      if (!open_) return {};
+      Lock lock(index_fd_, LOCK_SH);
+      if (!Refresh()) return {};
+      const Entry* entry{Find(player.substr(0, kMaxName).c_str(), false)};
+      return entry ? entry->totals[static_cast<int>(game)] : Totals{};
+    }
+
+    /**
+     * @brief The players with the most wins in a game, best first.
+     *
+     * Ties are broken by the fewest losses, then by name.
+     */
+    std::vector<Standing> Leaderboard(const Game game, const size_t top) {
+      std::vector<Standing> standings;
+      if (!open_) return standings;
+      Lock lock(index_fd_, LOCK_SH);
+      if (!Refresh()) return standings;
+      for (uint32_t slot{0}; slot < header_->capacity; ++slot) {
+        const Entry& entry{Entries()[slot]};
+        const Totals& totals{entry.totals[static_cast<int>(game)]};
+        if (entry.name[0] && totals.Games()) standings.push_back({entry.name, totals});
+      }
+      const auto better = [](const Standing& a, const Standing& b) {
+        if (a.totals.wins != b.totals.wins) return a.totals.wins > b.totals.wins;
+        if (a.totals.losses != b.totals.losses) return a.totals.losses < b.totals.losses;
+        return a.player < b.player;
+      };
+      const size_t count{std::min(top, standings.size())};
+      std::partial_sort(standings.begin(), standings.begin() + count, standings.end(), better);
+      standings.resize(count);
+      return standings;
+    }
+
+    /**
+     * @brief Rewrites the log with one record per player, game and outcome.
+     *
+     * The new log gets a new generation, an index of another generation is
+     * rebuilt when opened, so a crash at any point leaves a consistent store.
+     *
+     * @return True on success, false if the new log could not be written.
+     */
+    bool Compact() {
+      if (!open_) return false;
+      Lock lock(index_fd_, LOCK_EX);
+      return Refresh() && CompactLocked();
+    }
+
+   private:
+    static constexpr uint64_t kLogMagic{0x474f4c5354414753};   // "SGATSLOG"
+    static constexpr uint64_t kIndexMagic{0x5844495354414753}; // "SGATSIDX"
+
+    struct LogHeader {
+      uint64_t magic;
+      uint64_t generation;
+    };
+
+    struct IndexHeader {
+      uint64_t magic;
+      uint64_t log_generation; // The log whose records the index counts.
+      uint64_t log_records;    // How many of its records are counted.
+      uint32_t capacity;       // Slots of the hash table, a power of 2.
+      uint32_t num_players;
+    };
+
+    struct Entry {
+      char name[kMaxName + 1]; // Empty in a free slot.
+      Totals totals[kNumGames];
+    };
+
+    // Holds a flock for its lifetime, serializing the processes using the store
+    struct Lock {
+      Lock(const int fd, const int operation) : fd(fd) { flock(fd, operation); }
+      ~Lock() { flock(fd, LOCK_UN); }
+      int fd;
+    };
+
+    bool CompactLocked() {
+      std::vector<Record> records;
+      const int64_t now{std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()};
+      for (uint32_t slot{0}; slot < header_->capacity; ++slot) {
+        const Entry& entry{Entries()[slot]};
+        if (!entry.name[0]) continue;
+        for (int g{0}; g < kNumGames; ++g) {
+          const Totals& totals{entry.totals[g]};
+          const std::pair<Outcome, uint32_t> counts[]{
+              {Outcome::win, totals.wins}, {Outcome::loss, totals.losses}, {Outcome::draw, totals.draws}};
+          for (const auto& [outcome, count] : counts) {
+            if (!count) continue;
+            Record record{};
+            record.time = now;
+            std::memcpy(record.player, entry.name, sizeof(record.player));
+            record.game = static_cast<Game>(g);
+            record.outcome = outcome;
+            record.count = count;
+            records.push_back(record);
+          }
+        }
+      }
+      const uint64_t generation{NewGeneration()};
+      const std::string temporary{log_path_ + ".tmp"};
+      const int fd{open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+      if (fd < 0) return false;
+      const LogHeader log_header{kLogMagic, generation};
+      const size_t bytes{records.size() * sizeof(Record)};
+      const bool written{write(fd, &log_header, sizeof(log_header)) == sizeof(log_header) &&
+                         (bytes == 0 || write(fd, records.data(), bytes) == static_cast<ssize_t>(bytes)) &&
+                         fsync(fd) == 0};
+      close(fd);
+      if (!written || rename(temporary.c_str(), log_path_.c_str()) != 0) {
+        unlink(temporary.c_str());
+        return false;
+      }
+      close(log_fd_);
+      log_fd_ = open(log_path_.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+      header_->log_generation = log_generation_ = generation;
+      header_->log_records = records.size();
+      return log_fd_ >= 0;
+    }
+
+    static uint64_t NewGeneration() {
+      return std::random_device{}() ^ static_cast<uint64_t>(
+          std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    static size_t IndexSize(const uint32_t capacity) { return sizeof(IndexHeader) + capacity * sizeof(Entry); }
+
+    Entry* Entries() const { return reinterpret_cast<Entry*>(header_ + 1); }
+
+    bool Map(const size_t size) {
+      if (header_) munmap(header_, mapped_size_);
+      void* memory{mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, index_fd_, 0)};
+      header_ = memory == MAP_FAILED ? nullptr : static_cast<IndexHeader*>(memory);
+      mapped_size_ = header_ ? size : 0;
+      return header_ != nullptr;
+    }
+
+    /**
+     * @brief Follows another process that grew the index or compacted the log
+     *        since this one last looked.
+     */
+    bool Refresh() {
+      if (header_->log_generation != log_generation_) {
+        // The old log was replaced, appending to it would lose the record
+        close(log_fd_);
+        log_fd_ = open(log_path_.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+        if (log_fd_ < 0) return open_ = false;
+        log_generation_ = header_->log_generation;
+      }
+      if (header_->capacity == capacity_) return true;
+      capacity_ = header_->capacity;
+      return Map(IndexSize(capacity_));
+    }
+
+    /**
+     * @brief Maps the index and brings it up to date with the log.
+     *
+     * Called with the lock held.
+     */
+    bool Load() {
+      struct stat log_stat, index_stat;
+      if (fstat(log_fd_, &log_stat) != 0 || fstat(index_fd_, &index_stat) != 0) return false;
+      LogHeader log_header{};
+      if (log_stat.st_size < static_cast<off_t>(sizeof(LogHeader))) {
+        // A new store, or a log that died before its header was written
+        if (ftruncate(log_fd_, 0) != 0) return false;
+        log_header = {kLogMagic, NewGeneration()};
+        if (write(log_fd_, &log_header, sizeof(log_header)) != sizeof(log_header)) return false;
+        log_stat.st_size = sizeof(log_header);
+      } else if (pread(log_fd_, &log_header, sizeof(log_header), 0) != sizeof(log_header) ||
+                 log_header.magic != kLogMagic) {
+        std::cerr << "The stats log " << log_path_ << " is not valid" << std::endl;
+        return false;
+      }
+      // A record cut short by a crash is dropped
+      const uint64_t num_records{(log_stat.st_size - sizeof(LogHeader)) / sizeof(Record)};
+      if (ftruncate(log_fd_, sizeof(LogHeader) + num_records * sizeof(Record)) != 0) return false;
+
+      bool valid{index_stat.st_size >= static_cast<off_t>(sizeof(IndexHeader))};
+      if (valid) {
+        IndexHeader index_header{};
+        valid = pread(index_fd_, &index_header, sizeof(index_header), 0) == sizeof(index_header) &&
+                index_header.magic == kIndexMagic && index_header.log_generation == log_header.generation &&
+                index_header.log_records <= num_records &&
+                index_stat.st_size >= static_cast<off_t>(IndexSize(index_header.capacity));
+        if (valid) {
+          capacity_ = index_header.capacity;
+          if (!Map(IndexSize(capacity_))) return false;
+        }
+      }
+      if (!valid && !Reset(log_header.generation, std::max<off_t>(index_stat.st_size, IndexSize(64)))) return false;
+      log_generation_ = log_header.generation;
+      return Replay(header_->log_records, num_records);
+    }
+
+    /**
+     * @brief Empties the index, never shrinking the file other processes may have mapped.
+     */
+    bool Reset(const uint64_t generation, const size_t size) {
+      uint32_t capacity{64};
+      while (IndexSize(capacity * 2) <= size) capacity *= 2;
+      if (ftruncate(index_fd_, size) != 0 || !Map(size)) return false;
+      std::memset(header_, 0, size);
+      *header_ = {kIndexMagic, generation, 0, capacity, 0};
+      capacity_ = capacity;
+      return true;
+    }
+
+    /**
+     * @brief Adds the log records in [begin, end) to the index.
+     */
+    bool Replay(uint64_t begin, const uint64_t end) {
+      std::vector<Record> buffer(4096);
+      while (begin < end) {
+        const size_t count{static_cast<size_t>(std::min<uint64_t>(buffer.size(), end - begin))};
+        const ssize_t bytes{pread(log_fd_, buffer.data(), count * sizeof(Record),
+                                  sizeof(LogHeader) + begin * sizeof(Record))};
+        if (bytes != static_cast<ssize_t>(count * sizeof(Record))) return false;
+        for (size_t i{0}; i < count; ++i)
+          if (!Apply(buffer[i])) return false;
+        begin += count;
+        header_->log_records = begin;
+      }
+      return true;
+    }
+
+    static uint64_t Hash(const char* name) {
+      uint64_t hash{1469598103934665603ULL};
+      for (; *name; ++name) hash = (hash ^ static_cast<unsigned char>(*name)) * 1099511628211ULL;
+      return hash;
+    }
+
+    /**
+     * @brief The entry of a player, linear probing from its hash.
+     *
+     * @param insert Whether to take a free slot if the player has none.
+     * @return The entry, nullptr if the player has none and `insert` is false.
+     */
+    Entry* Find(const char* name, const bool insert) const {
+      const uint32_t mask{header_->capacity - 1};
+      for (uint32_t slot{static_cast<uint32_t>(Hash(name)) & mask};; slot = (slot + 1) & mask) {
+        Entry& entry{Entries()[slot]};
+        if (std::strncmp(entry.name, name, kMaxName) == 0 && entry.name[0]) return &entry;
+        if (entry.name[0]) continue;
+        if (!insert) return nullptr;
+        std::memcpy(entry.name, name, std::min(std::strlen(name), kMaxName));
+        ++header_->num_players;
+        return &entry;
+      }
+    }
+
+    /**
+     * @brief Doubles the hash table, keeping it at most half full.
+     */
+    bool Grow() {
+      std::vector<Entry> entries;
+      for (uint32_t slot{0}; slot < header_->capacity; ++slot)
+        if (Entries()[slot].name[0]) entries.push_back(Entries()[slot]);
+      const IndexHeader old{*header_};
+      if (!Reset(old.log_generation, IndexSize(old.capacity * 2))) return false;
+      header_->log_records = old.log_records;
+      for (const Entry& entry : entries) *Find(entry.name, true) = entry;
+      return true;
+    }
+
+    bool Apply(const Record& record) {
+      if (static_cast<int>(record.game) >= kNumGames || !record.player[0]) return true;
+      if (2 * (header_->num_players + 1) > header_->capacity && !Grow()) return false;
+      char name[kMaxName + 1]{};
+      std::memcpy(name, record.player, kMaxName);
+      Totals& totals{Find(name, true)->totals[static_cast<int>(record.game)]};
+      if (record.outcome == Outcome::win) totals.wins += record.count;
+      else if (record.outcome == Outcome::loss) totals.losses += record.count;
+      else totals.draws += record.count;
+      return true;
+    }
+
+    std::string log_path_;
+    int log_fd_{-1};
+    int index_fd_{-1};
+    uint64_t log_generation_{0};
+    IndexHeader* header_{nullptr};
+    size_t mapped_size_{0};
+    uint32_t capacity_{0};
+    bool open_{false};
+  };
+
+  /**
+   * @brief Records a result of the current player and prints their record in the game.
+   *
+   * The game goes on without stats if the store cannot be opened.
+   */
+  inline void RecordResult(const Game game, const Outcome outcome) {
+    Store store;
+    const std::string player{CurrentPlayer()};
+    if (!store.Add(player, game, outcome)) {
+      std::cerr << "Could not save the result in " << DefaultPrefix() << ".log" << std::endl;
+      return;
+    }
+    const Totals totals{store.Get(player, game)};
+    std::cout << player << " in " << kGameNames[static_cast<int>(game)] << ": " << totals.wins << " wins, "
+              << totals.losses << " losses, " << totals.draws << " draws" << std::endl;
+  }
+}
+
+#endif // STATS_STORE_H
@@ -0,0 +1,110 @@
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Count, mean and variance of a stream of values in constant memory.
+ *
+ * Uses Welford's update, and Chan's formula to merge two accumulators.
+ */
+class RunningStats {
+ public:
+  void Add(const double value) {
+    ++count_;
+    const double delta{value - mean_};
+    mean_ += delta / count_;
+    m2_ += delta * (value - mean_);
+  }
+
+  void Merge(const RunningStats& other) {
+    if (other.count_ == 0) return;
+    const uint64_t count{count_ + other.count_};
+    const double delta{other.mean_ - mean_};
+    mean_ += delta * other.count_ / count;
+    m2_ += other.m2_ + delta * delta * (static_cast<double>(count_) * other.count_ / count);
+    count_ = count;
+  }
+
+  uint64_t Count() const { return count_; }
+  double Mean() const { return mean_; }
+  double StdDev() const { return count_ > 1 ? std::sqrt(m2_ / (count_ - 1)) : 0.0; }
+
+ private:
+  uint64_t count_{0};
+  double mean_{0};
+  double m2_{0};
+};
+
+/**
+ * @brief Mergeable quantile sketch with relative accuracy guarantees (DDSketch).
+ *
+ * Positive values fall in logarithmic buckets of ratio gamma, so any quantile
+ * is returned within `relative_accuracy` of the true value. The buckets are a
+ * fixed array covering [min_value, max_value] (values outside are clamped),
+ * so memory does not grow with the number of values.
+ */
+class QuantileSketch {
+ public:
+  explicit QuantileSketch(const double relative_accuracy = 0.01, const double min_value = 1e-3,
+                          const double max_value = 1e12)
+      : gamma_((1 + relative_accuracy) / (1 - relative_accuracy)),
+        log_gamma_(std::log(gamma_)),
+        min_value_(min_value),
+        offset_(Key(min_value)),
+        counts_(Key(max_value) - offset_ + 1, 0) {}
+
+  void Add(const double value) {
+    ++count_;
+    if (value < min_value_) {
+      ++zero_count_;
+      return;
+    }
+    const int bucket{std::min(Key(value) - offset_, static_cast<int>(counts_.size()) - 1)};
+    ++counts_[bucket];
+  }
+
+  /**
+   * @brief Adds the values of another sketch built with the same parameters.
+   */
+  void Merge(const QuantileSketch& other) {
+    count_ += other.count_;
+    zero_count_ += other.zero_count_;
+    for (size_t i{0}; i < counts_.size(); ++i) counts_[i] += other.counts_[i];
+  }
+
+  /**
+   * @brief The value at quantile q, values below the minimum are reported as 0.
+   *
+   * @param q The quantile, between 0 and 1.
+   */
+  double Quantile(const double q) const {
+    if (count_ == 0) return 0;
+    const uint64_t rank{static_cast<uint64_t>(q * (count_ - 1))};
+    uint64_t seen{zero_count_};
+    if (rank < seen) return 0;
+    for (size_t i{0}; i < counts_.size(); ++i) {
+      seen += counts_[i];
+      if (rank < seen) return 2 * std::pow(gamma_, static_cast<int>(i) + offset_) / (gamma_ + 1);
+    }
+    return 2 * std::pow(gamma_, static_cast<int>(counts_.size()) - 1 + offset_) / (gamma_ + 1);
+  }
+
+  uint64_t Count() const { return count_; }
+
+ private:
+  int Key(const double value) const { return static_cast<int>(std::ceil(std::log(value) / log_gamma_)); }
+
+  double gamma_;
+  double log_gamma_;
+  double min_value_;
+  int offset_;
+  std::vector<uint64_t> counts_;
+  uint64_t count_{0};
+  uint64_t zero_count_{0};
+};
+
+#endif // STREAMING_STATS_H
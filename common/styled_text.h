@@ -0,0 +1,147 @@
+#ifndef STYLED_TEXT_H
+#define STYLED_TEXT_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Styled {
+  // SGR codes of the default colors
+  constexpr int kDefaultForeground{39};
+  constexpr int kDefaultBackground{49};
+
+  struct Style {
+    int foreground{kDefaultForeground};
+    int background{kDefaultBackground};
+    bool bold{false};
+
+    bool operator==(const Style& other) const {
+      return foreground == other.foreground && background == other.background && bold == other.bold;
+    }
+    bool operator!=(const Style& other) const { return !(*this == other); }
+  };
+
+  /**
+   * @brief Text with styles, gathered for a whole frame and written at once.
+   *
+   * Text written with the same style is kept as one run. When rendered, a
+   * single SGR sequence is emitted between runs and only with the attributes
+   * that really change; runs of spaces keep the current colors, as only the
+   * background would show on them.
+   */
+  class Text {
+   public:
+    /**
+     * @brief Applies an SGR code to the style of the text that follows.
+     *
+     * Understands reset (0), bold (1, 22) and the foreground (30-37, 39, 90-97)
+     * and background (40-47, 49, 100-107) colors, other codes are ignored.
+     */
+    Text& Apply(const int code) {
+      if (code == 0) style_ = Style{};
+      else if (code == 1) style_.bold = true;
+      else if (code == 22) style_.bold = false;
+      else if ((code >= 30 && code <= 39) || (code >= 90 && code <= 97)) style_.foreground = code;
+      else if ((code >= 40 && code <= 49) || (code >= 100 && code <= 107)) style_.background = code;
+      return *this;
+    }
+
+    Text& operator<<(const Style& style) {
+      style_ = style;
+      return *this;
+    }
+
+    Text& operator<<(const std::string& text) {
+      Append(text.data(), text.size());
+      return *this;
+    }
+
+    Text& operator<<(const char* text) { return *this << std::string(text); }
+
+    Text& operator<<(const char c) {
+      Append(&c, 1);
+      return *this;
+    }
+
+    template<typename Number, typename = std::enable_if_t<std::is_arithmetic_v<Number>>>
+    Text& operator<<(const Number number) {
+      return *this << std::to_string(number);
+    }
+
+    /**
+     * @brief The text with the escape sequences, ending with the default style.
+     */
+    std::string Render() const {
+      std::string output;
+      output.reserve(text_.size() + 8 * runs_.size());
+      Style shown{};
+      size_t begin{0};
+      for (const Run& run : runs_) {
+        const bool blank{text_.find_first_not_of(' ', begin) >= run.end};
+        Style wanted{run.style};
+        if (blank) {
+          wanted.foreground = shown.foreground;
+          wanted.bold = shown.bold;
+        }
+        AppendChange(shown, wanted, output);
+        shown = wanted;
+        output.append(text_, begin, run.end - begin);
+        begin = run.end;
+      }
+      AppendChange(shown, Style{}, output);
+      return output;
+    }
+
+    /**
+     * @brief Writes the text in a single write and empties it, the style is kept.
+     */
+    void Flush(std::ostream& os = std::cout) {
+      const std::string output{Render()};
+      os.write(output.data(), static_cast<std::streamsize>(output.size()));
+      os.flush();
+      text_.clear();
+      runs_.clear();
+    }
+
+   private:
+    struct Run {
+      Style style;
+      size_t end; // Where the run ends in `text_`.
+    };
+
+    void Append(const char* text, const size_t size) {
+      if (size == 0) return;
+      text_.append(text, size);
+      if (!runs_.empty() && runs_.back().style == style_) runs_.back().end = text_.size();
+      else runs_.push_back({style_, text_.size()});
+    }
+
+    /**
+     * @brief Appends one SGR sequence with the attributes that differ, if any.
+     */
+    static void AppendChange(const Style& from, const Style& to, std::string& output) {
+      if (from == to) return;
+      std::string parameters;
+      const auto add = [&parameters](const int code) {
+        if (!parameters.empty()) parameters += ';';
+        parameters += std::to_string(code);
+      };
+      if (to == Style{}) {
+        add(0);
+      } else {
+        if (from.bold != to.bold) add(to.bold ? 1 : 22);
+        if (from.foreground != to.foreground) add(to.foreground);
+        if (from.background != to.background) add(to.background);
+      }
+      output += "\033[" + parameters + "m";
+    }
+
+    Style style_{};
+    std::string text_;
+    std::vector<Run> runs_;
+  };
+}
+
+#endif // STYLED_TEXT_H
@@ -0,0 +1,124 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace Console {
+  /**
+   * @brief Off-screen buffer for the frame being drawn.
+   *
+   * While a frame is open `std::cout` and `std::cerr` write into the buffer
+   * instead of the terminal. The frame is sent in a single write as soon as
+   * the program reads from `std::cin`, sleeps or exits, so the screen never
+   * shows a half drawn frame and no process is spawned to clear it.
+   */
+  class Frame : public std::stringbuf {
+   public:
+    Frame() : flusher_(this), tie_(&flusher_) {}
+
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+
+    ~Frame() override { Flush(); }
+
+    /**
+     * @brief Opens a new frame that starts on a blank screen.
+     *
+     * If a frame is already open, what it holds is discarded, it would be cleared anyway.
+     */
+    void Begin() {
+      str("");
+      sputn(kClear, sizeof(kClear) - 1);
+      if (open_) return;
+      cout_ = std::cout.rdbuf(this);
+      cerr_ = std::cerr.rdbuf(this);
+      // Reading input sends the frame first, so prompts are always visible
+      cin_tie_ = std::cin.tie(&tie_);
+      open_ = true;
+    }
+
+    /**
+     * @brief Writes the open frame to the terminal, if any.
+     */
+    void Flush() {
+      if (!open_) return;
+      open_ = false;
+      std::cout.rdbuf(cout_);
+      std::cerr.rdbuf(cerr_);
+      std::cin.tie(cin_tie_);
+      std::cout.flush();
+      std::fflush(stdout);
+      const std::string frame{str()};
+      str("");
+      for (size_t written{0}; written < frame.size();) {
+        const ssize_t result{write(STDOUT_FILENO, frame.data() + written, frame.size() - written)};
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+      }
+    }
+
+   private:
+    // Moves to the top left corner and clears the screen and the scrollback
+    static constexpr char kClear[]{"\033[H\033[2J\033[3J"};
+
+    /**
+     * @brief Stream buffer that only flushes the frame when it is synced.
+     */
+    class Flusher : public std::streambuf {
+     public:
+      explicit Flusher(Frame* frame) : frame_(frame) {}
+
+     protected:
+      int sync() override {
+        frame_->Flush();
+        return 0;
+      }
+
+     private:
+      Frame* frame_;
+    };
+
+    Flusher flusher_;
+    std::ostream tie_; // Tied to `std::cin` while the frame is open.
+    bool open_{false};
+    std::streambuf* cout_{nullptr};
+    std::streambuf* cerr_{nullptr};
+    std::ostream* cin_tie_{nullptr};
+  };
+
+  inline Frame frame;
+
+  /**
+   * @brief Clears the console screen.
+   *
+   * Everything written to the console until the next input is drawn together
+   * with the clear, in a single write.
+   */
+  inline void ClearScreen() { frame.Begin(); }
+
+  /**
+   * @brief Shows the open frame, if any, and waits.
+   *
+   * @param duration How long to wait.
+   */
+  inline void Sleep(const std::chrono::steady_clock::duration duration) {
+    frame.Flush();
+    std::this_thread::sleep_for(duration);
+  }
+
+  /**
+   * @brief Shows the open frame, if any, and waits.
+   *
+   * @param seconds The number of seconds to wait.
+   */
+  inline void Sleep(const int seconds) { Sleep(std::chrono::seconds(seconds)); }
+}
+
+#endif // TERMINAL_H
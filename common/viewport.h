@@ -0,0 +1,151 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Viewport {
+  /**
+   * @brief The part of a board that is shown on screen.
+   */
+  struct Window {
+    int first_row;
+    int first_col;
+    int rows;
+    int cols;
+  };
+
+  /**
+   * @brief The window of at most `max_rows` x `max_cols` cells centered on a cell.
+   *
+   * The window is kept inside the board, so near the borders the cell is off center.
+   *
+   * @param row The row to follow.
+   * @param col The column to follow.
+   * @param total_rows The number of rows of the board.
+   * @param total_cols The number of columns of the board.
+   * @param max_rows The maximum number of rows shown.
+   * @param max_cols The maximum number of columns shown.
+   * @return The window to show.
+   */
+  inline Window Around(const int row, const int col, const int total_rows, const int total_cols,
+                       const int max_rows, const int max_cols) {
+    Window window{0, 0, std::min(total_rows, max_rows), std::min(total_cols, max_cols)};
+    window.first_row = std::clamp(row - window.rows / 2, 0, total_rows - window.rows);
+    window.first_col = std::clamp(col - window.cols / 2, 0, total_cols - window.cols);
+    return window;
+  }
+
+  /**
+   * @brief Draws a bordered grid with some status lines above it.
+   *
+   * The renderer keeps what is on screen. The first frame is drawn whole,
+   * then `Present` only moves the cursor to the cells and status lines that
+   * changed and rewrites them, so the cost of a frame is bounded by the
+   * changes instead of by the size of the grid. Every frame is sent in a
+   * single write and leaves the cursor under the grid, ready for a prompt.
+   */
+  class GridRenderer {
+   public:
+    /**
+     * @param rows The number of rows of cells shown.
+     * @param cols The number of columns of cells shown.
+     * @param num_status_lines The number of lines above the grid.
+     * @param cell_width The width in terminal columns of every cell, without borders.
+     * @param top_border Whether the grid is closed at the top.
+     */
+    GridRenderer(const int rows, const int cols, const int num_status_lines, const int cell_width = 4,
+                 const bool top_border = true)
+        : rows_(rows), cols_(cols), cell_width_(cell_width), top_border_(top_border),
+          cells_(rows * cols, std::string(cell_width, ' ')), shown_cells_(cells_.size()),
+          status_(num_status_lines), shown_status_(num_status_lines) {}
+
+    void SetStatus(const int line, const std::string& text) { status_[line] = text; }
+
+    /**
+     * @brief Sets the content of a cell, it must be `cell_width` terminal columns wide.
+     */
+    void SetCell(const int row, const int col, const std::string& content) { cells_[row * cols_ + col] = content; }
+
+    /**
+     * @brief Forces the next frame to be drawn whole, e.g. if something else wrote on the screen.
+     */
+    void Invalidate() { full_redraw_ = true; }
+
+    /**
+     * @brief Writes the changes since the last frame to the terminal.
+     */
+    void Present() {
+      buffer_.clear();
+      if (full_redraw_) {
+        DrawAll();
+        full_redraw_ = false;
+      } else {
+        for (size_t line{0}; line < status_.size(); ++line) {
+          if (status_[line] == shown_status_[line]) continue;
+          MoveTo(static_cast<int>(line) + 1, 1);
+          buffer_ += status_[line];
+          buffer_ += "\033[K";
+        }
+        for (int row{0}; row < rows_; ++row) {
+          for (int col{0}; col < cols_; ++col) {
+            const std::string& cell = cells_[row * cols_ + col];
+            if (cell == shown_cells_[row * cols_ + col]) continue;
+            MoveTo(CellLine(row), col * (cell_width_ + 1) + 2);
+            buffer_ += cell;
+          }
+        }
+      }
+      // Leave the cursor under the grid and clear what the last prompt left there
+      MoveTo(CellLine(rows_ - 1) + 2, 1);
+      buffer_ += "\033[J";
+      std::cout.write(buffer_.data(), buffer_.size());
+      std::cout.flush();
+      shown_cells_ = cells_;
+      shown_status_ = status_;
+    }
+
+   private:
+    /**
+     * @brief The terminal line (from 1) of a row of cells.
+     */
+    int CellLine(const int row) const {
+      return static_cast<int>(status_.size()) + 1 + (top_border_ ? 1 : 0) + 2 * row;
+    }
+
+    void MoveTo(const int line, const int column) {
+      buffer_ += "\033[" + std::to_string(line) + ";" + std::to_string(column) + "H";
+    }
+
+    void AppendBorder() {
+      for (int col{0}; col < cols_; ++col) buffer_ += "+" + std::string(cell_width_, '-');
+      buffer_ += "+\n";
+    }
+
+    void DrawAll() {
+      buffer_ += "\033[H\033[2J";
+      for (const std::string& line : status_) buffer_ += line + "\n";
+      for (int row{0}; row < rows_; ++row) {
+        if (row > 0 || top_border_) AppendBorder();
+        for (int col{0}; col < cols_; ++col) buffer_ += "|" + cells_[row * cols_ + col];
+        buffer_ += "|\n";
+      }
+      AppendBorder();
+    }
+
+    int rows_;
+    int cols_;
+    int cell_width_;
+    bool top_border_;
+    bool full_redraw_{true};
+    std::vector<std::string> cells_;        // The cells of the next frame.
+    std::vector<std::string> shown_cells_;  // The cells on screen.
+    std::vector<std::string> status_;       // The status lines of the next frame.
+    std::vector<std::string> shown_status_; // The status lines on screen.
+    std::string buffer_;
+  };
+}
+
+#endif // VIEWPORT_H
@@ -0,0 +1,68 @@
+#ifndef WORD_FILE_H
+#define WORD_FILE_H
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "random.h"
+
+/**
+ * @brief Count the number of lines in a file.
+ * 
+ * @param input_file_name The name of the input file.
+ * @return The number of lines in the file. Returns 0 if the file cannot be opened.
+ */
+inline int GetNumLinesFromFile(const std::string& input_file_name) {
+  std::ifstream input_file(input_file_name); 
+  if (!input_file.is_open()) return 0;
+  return std::count(std::istreambuf_iterator<char>(input_file),
+                    std::istreambuf_iterator<char>(), '\n');
+}
+
+/**
+ * @brief Retrieve a random word from a file.
+ * 
+ * @param input_file_name The name of the input file.
+ * @return The first word of a random line of the file, or an empty string if the file cannot be opened.
+ */
+inline std::string RandomWordFromFile(const std::string& input_file_name) {
+  std::ifstream input_file(input_file_name); 
+  if (!input_file.is_open()) return "";
+  const int num_lines{GetNumLinesFromFile(input_file_name)};
+  // Lines are counted from 1, every one of them is equally likely
+  const int target_line{GetRandomNum(1, std::max(num_lines, 1))};
+  int current_line{0};
+  std::string line;
+  while (std::getline(input_file, line)) {
+    if (++current_line == target_line) break;
+  }
+  std::istringstream line_stream(line);
+  std::string word{};
+  // A line can have multiple words, so we get the first one
+  line_stream >> word;
+  return word;
+}
+
+/**
+ * @brief Read the first word of every line of a file.
+ *
+ * @param input_file_name The name of the input file.
+ * @return The words, empty if the file cannot be opened.
+ */
+inline std::vector<std::string> ReadWordsFromFile(const std::string& input_file_name) {
+  std::vector<std::string> words;
+  std::ifstream input_file(input_file_name);
+  std::string line;
+  while (std::getline(input_file, line)) {
+    std::istringstream line_stream(line);
+    std::string word;
+    if (line_stream >> word) words.push_back(word);
+  }
+  return words;
+}
+
+#endif // WORD_FILE_H
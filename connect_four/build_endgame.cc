@@ -0,0 +1,106 @@
+// Solves the endgame of Connect Four backwards and writes the table the PC probes.
+//
+//   build_endgame [--empty n] [--seeds n] [--games file] [--seed s] [--out file]
+//
+// Every position with n empty cells (12 by default) is a seed: some come from
+// games between a user who wins or blocks when they can and the PC's random
+// policy, others from the games of a file, one string of columns (1-7) per
+// line. Endgame::Build solves every position reachable from the seeds; both of
+// its passes split every layer across the cores. Run from connect_four/ so the
+// game finds endgame.db. Real games hardly ever meet a position of this table:
+// the game builds one from its own position once it has few enough empty cells.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "connect_four_bitboard.h"
+#include "connect_four_endgame.h"
+
+/**
+ * @brief Plays games until one reaches the seed depth without a win: a user
+ *        who wins or blocks when they can, otherwise plays at random, against
+ *        the PC's random policy.
+ */
+Bitboard RandomSeed(const int num_empty, std::mt19937& generator) {
+  while (true) {
+    Bitboard position;
+    const bool user_first{generator() % 2 == 0};
+    while (position.NumEmpty() > num_empty) {
+      std::vector<int> moves;
+      for (int col{0}; col < Bitboard::kWidth; ++col)
+        if (position.CanPlay(col)) moves.push_back(col);
+      int col{moves[generator() % moves.size()]};
+      if (user_first == (position.NumEmpty() % 2 == 0)) {
+        Bitboard opponent{position};
+        opponent.current ^= opponent.mask;
+        for (const int move : moves)
+          if (opponent.IsWinningMove(move)) col = move;
+        for (const int move : moves)
+          if (position.IsWinningMove(move)) col = move;
+      }
+      if (position.IsWinningMove(col)) break;
+      position.Play(col);
+    }
+    if (position.NumEmpty() == num_empty) return position.Canonical();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int num_empty{12};
+  uint64_t num_seeds{2000}, seed{std::random_device{}()};
+  std::string games_file, out_file{"endgame.db"};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--empty") == 0 && i + 1 < argc) num_empty = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--seeds") == 0 && i + 1 < argc) num_seeds = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) games_file = argv[++i];
+    else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_file = argv[++i];
+  }
+  if (num_empty < 1 || num_empty > Bitboard::kWidth * Bitboard::kHeight) {
+    std::cerr << "The number of empty cells must be between 1 and 42" << std::endl;
+    return 1;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  Endgame::Layer seeds;
+  std::mt19937 generator(static_cast<uint32_t>(seed));
+  for (uint64_t s{0}; s < num_seeds; ++s) seeds.push_back(RandomSeed(num_empty, generator));
+  if (!games_file.empty()) {
+    std::ifstream games(games_file);
+    if (!games.is_open()) {
+      std::cerr << "Could not read " << games_file << std::endl;
+      return 1;
+    }
+    std::string moves;
+    uint64_t num_games{0};
+    while (std::getline(games, moves)) {
+      // Games that ended before the seed depth have nothing to add
+      Bitboard position;
+      const size_t seed_moves{static_cast<size_t>(Bitboard::kWidth * Bitboard::kHeight - num_empty)};
+      if (moves.size() < seed_moves || !Bitboard::FromMoves(moves.substr(0, seed_moves), position)) continue;
+      seeds.push_back(position.Canonical());
+      ++num_games;
+    }
+    std::cout << num_games << " seeds from " << games_file << std::endl;
+  }
+  const std::vector<std::pair<uint64_t, uint8_t>> entries{Endgame::Build(std::move(seeds), num_empty)};
+  std::cout << entries.size() << " positions with at most " << num_empty << " empty cells" << std::endl;
+  if (!Endgame::Write(out_file, entries, num_empty)) {
+    std::cerr << "Could not write " << out_file << std::endl;
+    return 1;
+  }
+  uint64_t results[3]{};
+  for (const auto& entry : entries) ++results[Endgame::Value::Decode(entry.second).result];
+  const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  std::cout << "Wins " << results[Endgame::win] << ", draws " << results[Endgame::draw] << ", losses "
+            << results[Endgame::loss] << " for the player to move, written to " << out_file << " in " << seconds
+            << " s" << std::endl;
+}
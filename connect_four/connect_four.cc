@@ -1,63 +1,54 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <random>
 #include <iostream>
 #include <vector>
 
-std::mt19937 generator(std::random_device{}());
+#include "../common/fairness.h"
+#include "../common/keyboard.h"
+#include "../common/latency.h"
+#include "../common/parallel.h"
+#include "../common/random.h"
+#include "../common/stats_store.h"
+#include "../common/viewport.h"
+#include "connect_four_analysis.h"
+#include "connect_four_bitboard.h"
+#include "connect_four_endgame.h"
+#include "connect_four_rules.h"
+#include "connect_four_solver.h"
 
-int GetRandomInt(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
-}
-
-const int rows{6}, cols{7};
-
-enum Connect {
-  empty,
-  yellow,
-  red
-};
-
-bool IsGridFull(const std::vector<std::vector<Connect>>& grid) {
-  for (const auto& row : grid)
-    for (const auto& connect : row)
-      if (connect == empty) return false;
-  return true;
-}
+// Printed on exit with --stats
+Latency::Metric input_latency{"input"};
+Latency::Metric pc_latency{"pc move"};
+Latency::Metric render_latency{"render"};
+Latency::Metric rules_latency{"win check"};
+// Where the late PC moves came from, their counts against the PC moves are the table's hit rate
+Latency::Metric probe_latency{"table probe"};
+Latency::Metric build_latency{"table build"};
+Latency::Metric solve_latency{"solver"};
 
-bool CheckWin(const std::vector<std::vector<Connect>>& grid) {
-  // Check rows
-  for (int i = 0; i < rows; ++i)
-    for (int j = 0; j < cols - 3; ++j)
-      if (grid[i][j] != empty && grid[i][j] == grid[i][j + 1] && 
-          grid[i][j] == grid[i][j + 2] && grid[i][j] == grid[i][j + 3])
-        return true;
-  // Check columns
-  for (int i = 0; i < rows - 3; ++i)
-    for (int j = 0; j < cols; ++j)
-      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j] && 
-          grid[i][j] == grid[i + 2][j] && grid[i][j] == grid[i + 3][j])
-        return true;
-  // Check diagonals (top-left to bottom-right)
-  for (int i = 0; i < rows - 3; ++i)
-    for (int j = 0; j < cols - 3; ++j)
-      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j + 1] && 
-          grid[i][j] == grid[i + 2][j + 2] && grid[i][j] == grid[i + 3][j + 3])
-        return true;
-  // Check diagonals (top-right to bottom-left)
-  for (int i = 0; i < rows - 3; ++i)
-    for (int j = 3; j < cols; ++j)
-      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j - 1] && 
-          grid[i][j] == grid[i + 2][j - 2] && grid[i][j] == grid[i + 3][j - 3])
-        return true;
-  return false;
-}
+// Solved late positions, built by build_endgame, the PC plays them perfectly
+Endgame::Table endgame_table;
+// Real games hardly ever meet the positions of endgame.db: from this many empty cells the PC
+// solves every position its own game can reach, in 90 ms on average and 1.5 s at worst on one core
+const int kSeedEmpty{20};
+Endgame::Table game_table;
+// Before that, the solver takes the last few moves the tables cannot have
+const int kSolveEmpty{22};
 
 void UserInput(std::vector<std::vector<Connect>>& grid) {
+  Latency::ScopedTimer timer(input_latency);
   while (true) {
-    std::cout << "Say the column (1 - 7): ";
-    int user_input;
-    std::cin >> user_input;
-    --user_input;
+    std::cout << "Say the column (1 - 7): " << std::flush;
+    // A digit plays at once, there is no need to press enter
+    Keyboard::Key key{Keyboard::input.Read()};
+    while (key.code == Keyboard::enter) key = Keyboard::input.Read();
+    if (key.code == Keyboard::end_of_input) std::exit(0);
+    if (key.code == Keyboard::character) std::cout << key.ch;
+    std::cout << std::endl;
+    const int user_input{key.code == Keyboard::character ? key.ch - '1' : -1};
     if (user_input < 0 || user_input > 6) {
       std::cout << "This number is not valid, must be between 1 and 7" << std::endl;
       continue;
@@ -75,64 +66,150 @@ void UserInput(std::vector<std::vector<Connect>>& grid) {
   }
 }
 
-void PCInput(std::vector<std::vector<Connect>>& grid) {
+int PCColumn(const std::vector<std::vector<Connect>>& grid) {
   while (true) {
-    int pc_input = GetRandomInt(0, rows);
-    if (grid[0][pc_input] != empty) continue;
-    for (int i{rows - 1}; i >= 0; --i) {
-      if (grid[i][pc_input] == empty) {
-        grid[i][pc_input] = red;
-        return;
-      }
+    const int pc_input = GetRandomNum(0, cols - 1);
+    if (grid[0][pc_input] == empty) return pc_input;
+  }
+}
+
+/**
+ * @brief The best column of a late position, probed from a table or else solved.
+ *
+ * Once the game has at most `kSeedEmpty` empty cells the game table holds
+ * every position left, every move after that is a probe.
+ *
+ * @return The column, -1 while too many cells are empty to solve.
+ */
+int ExactColumn(const Bitboard& position) {
+  const auto start = std::chrono::steady_clock::now();
+  int col{Endgame::BestColumn(endgame_table, position)};
+  if (col < 0) col = Endgame::BestColumn(game_table, position);
+  if (col >= 0) {
+    probe_latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                             .count());
+    return col;
+  }
+  if (position.NumEmpty() <= kSeedEmpty) {
+    Latency::ScopedTimer timer(build_latency);
+    game_table.Assign(Endgame::Build({position.Canonical()}, position.NumEmpty()), position.NumEmpty());
+    return Endgame::BestColumn(game_table, position);
+  }
+  if (position.NumEmpty() > kSolveEmpty) return -1;
+  Latency::ScopedTimer timer(solve_latency);
+  // Built on the first late position, its transposition table carries over to the next moves
+  static Solver solver;
+  return solver.BestColumn(position);
+}
+
+void PCInput(std::vector<std::vector<Connect>>& grid) {
+  Latency::ScopedTimer timer(pc_latency);
+  // Random until the position is late enough to play perfectly
+  int pc_input = ExactColumn(Bitboard::FromGrid(grid, red));
+  if (pc_input < 0) pc_input = PCColumn(grid);
+  for (int i{rows - 1}; i >= 0; --i) {
+    if (grid[i][pc_input] == empty) {
+      grid[i][pc_input] = red;
+      return;
     }
   }
 }
 
-void PrintGrid(const std::vector<std::vector<Connect>>& grid) {
-  std::cout << "\n";
+// The PC must pick every column that is not full with the same probability
+bool CheckFairness(const uint64_t num_draws) {
+  std::vector<std::vector<Connect>> grid(rows, {cols, empty});
+  bool passed = Fairness::Run("connect four PC column, empty grid", num_draws,
+                              std::vector<double>(cols, 1.0 / cols), [&grid] { return PCColumn(grid); });
+  // Fill the first and the fifth columns, they must never be chosen
+  std::vector<double> probabilities(cols, 1.0 / (cols - 2));
+  probabilities[0] = probabilities[4] = 0;
+  for (int i{0}; i < rows; ++i) grid[i][0] = grid[i][4] = red;
+  passed &= Fairness::Run("connect four PC column, two full columns", num_draws, probabilities,
+                          [&grid] { return PCColumn(grid); });
+  return passed;
+}
+
+void PrintGrid(const std::vector<std::vector<Connect>>& grid, Viewport::GridRenderer& renderer) {
+  Latency::ScopedTimer timer(render_latency);
   for (int i{0}; i < rows; ++i) {
-    // Print the top part of cell
-    if (i != 0) {
-      for (int j{0}; j < cols; ++j) std::cout << "+----";
-      std::cout << "+";
-    }
-    std::cout << "\n";
-    // Print the content of the cell
     for (int j{0}; j < cols; ++j) {
-      std::cout << "|";
       if (grid[i][j] == yellow) 
-        std::cout << " 🟡 ";
+        renderer.SetCell(i, j, " 🟡 ");
       else if (grid[i][j] == red) 
-        std::cout << " 🔴 ";
-      else std::cout << "    ";
+        renderer.SetCell(i, j, " 🔴 ");
+      else renderer.SetCell(i, j, "    ");
     }
-    std::cout << "|\n";
   }
-  // Print the down part of the cell
-  for (int j{0}; j < cols; ++j) 
-    std::cout << "+----";
-  std::cout << "+\n";
+  renderer.Present();
 }
 
-int main() {
+/**
+ * @brief Scores every column of the positions of a file, or of stdin, with
+ *        `--analyze [file] [--threads n]`.
+ *
+ * @param status Set to the exit status when the flag is given.
+ * @return True if the flag was given.
+ */
+bool RunAnalysis(const int argc, char* argv[], int& status) {
+  std::string file_name;
+  bool analyze{false};
+  unsigned num_threads{Parallel::NumThreads()};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--analyze") == 0) {
+      analyze = true;
+      if (i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0) file_name = argv[++i];
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      num_threads = std::max(1, std::atoi(argv[++i]));
+    }
+  }
+  if (!analyze) return false;
+  std::ifstream file;
+  if (!file_name.empty()) {
+    file.open(file_name);
+    if (!file.is_open()) {
+      std::cerr << "Could not read " << file_name << std::endl;
+      status = 1;
+      return true;
+    }
+  }
+  std::ios::sync_with_stdio(false);
+  const Analysis::Summary summary{Analysis::Run(file_name.empty() ? std::cin : file, std::cout, num_threads)};
+  std::cerr << summary.positions << " positions in " << summary.seconds << " s ("
+            << summary.positions / summary.seconds << " positions/s, " << summary.nodes << " nodes)" << std::endl;
+  status = 0;
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  if (const uint64_t num_draws{Fairness::ParseFlag(argc, argv)})
+    return CheckFairness(num_draws) ? 0 : 1;
+  if (int status; RunAnalysis(argc, argv, status)) return status;
+  Latency::ParseFlag(argc, argv);
+  endgame_table.Load("endgame.db");
+  const auto won = [](const std::vector<std::vector<Connect>>& grid) {
+    return Latency::Time(rules_latency, [&grid] { return CheckWin(grid); });
+  };
   std::vector<std::vector<Connect>> grid(rows, {cols, empty});
+  // Only the changed cells are redrawn after the first frame
+  Viewport::GridRenderer renderer(rows, cols, 1, 4, false);
   while (!IsGridFull(grid)) {
-    system("clear");
-    PrintGrid(grid);
+    PrintGrid(grid, renderer);
     UserInput(grid);
-    if (CheckWin(grid)) {
-      system("clear");
-      PrintGrid(grid);
+    if (won(grid)) {
+      PrintGrid(grid, renderer);
       std::cout << "You won!" << std::endl;
+      Stats::RecordResult(Stats::Game::connect_four, Stats::Outcome::win);
       return 0;
     }
     PCInput(grid);
-    if (CheckWin(grid)) {
-      system("clear");
-      PrintGrid(grid);
+    if (won(grid)) {
+      PrintGrid(grid, renderer);
       std::cout << "You lost!" << std::endl;
+      Stats::RecordResult(Stats::Game::connect_four, Stats::Outcome::loss);
       return 0;
     }
   }
+  PrintGrid(grid, renderer);
   std::cout << "It's a draw!" << std::endl;
-}
\ No newline at end of file
+  Stats::RecordResult(Stats::Game::connect_four, Stats::Outcome::draw);
+}
@@ -0,0 +1,171 @@
+#ifndef CONNECT_FOUR_ANALYSIS_H
+#define CONNECT_FOUR_ANALYSIS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "connect_four_bitboard.h"
+#include "connect_four_solver.h"
+
+/**
+ * Scores every column of a stream of positions, one string of columns (1-7)
+ * per line, as `<moves> <score of column 1> ... <score of column 7>` with `x`
+ * for a full column, or `<moves> invalid`.
+ *
+ * Three stages overlap: the calling thread parses lines into batches, the
+ * workers solve them, each with its own solver whose transposition table
+ * carries over from position to position, and a writer prints the batches
+ * in input order as soon as they are done. A bounded number of batches is
+ * in flight, so any length of input runs in constant memory.
+ */
+namespace Analysis {
+  const size_t kBatchSize{64};
+
+  struct Batch {
+    uint64_t index;
+    std::vector<std::string> lines;
+    std::string output;
+  };
+
+  struct Summary {
+    uint64_t positions{0};
+    uint64_t nodes{0};
+    double seconds{0};
+  };
+
+  inline std::string AnalyzeLine(Solver& solver, const std::string& line) {
+    Bitboard position;
+    if (!Bitboard::FromMoves(line, position)) return line + " invalid\n";
+    std::string output{line};
+    for (const int score : solver.Analyze(position))
+      output += score == Solver::kInvalid ? " x" : " " + std::to_string(score);
+    return output + "\n";
+  }
+
+  class Pipeline {
+   public:
+    Pipeline(std::ostream& out, const unsigned num_threads) : out_(out), max_in_flight_(4 * num_threads) {
+      writer_ = std::thread([this] { Write(); });
+      for (unsigned t{0}; t < num_threads; ++t) workers_.emplace_back([this] { Work(); });
+    }
+
+    /**
+     * @brief Queues a batch, waiting while too many are in flight.
+     */
+    void Push(std::unique_ptr<Batch> batch) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      space_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+      ++in_flight_;
+      ++num_batches_;
+      todo_.push_back(std::move(batch));
+      work_.notify_one();
+    }
+
+    /**
+     * @brief Waits for every batch to be written.
+     *
+     * @return The number of search nodes of every worker.
+     */
+    uint64_t Finish() {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        input_done_ = true;
+      }
+      work_.notify_all();
+      done_.notify_all();
+      for (auto& worker : workers_) worker.join();
+      writer_.join();
+      return nodes_;
+    }
+
+   private:
+    void Work() {
+      Solver solver;
+      while (true) {
+        std::unique_ptr<Batch> batch;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          work_.wait(lock, [this] { return input_done_ || !todo_.empty(); });
+          if (todo_.empty()) break;
+          batch = std::move(todo_.front());
+          todo_.pop_front();
+        }
+        for (const std::string& line : batch->lines) batch->output += AnalyzeLine(solver, line);
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_[batch->index] = std::move(batch);
+        done_.notify_one();
+      }
+      nodes_ += solver.NumNodes();
+    }
+
+    void Write() {
+      for (uint64_t next{0};; ++next) {
+        std::unique_ptr<Batch> batch;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          done_.wait(lock, [this, next] { return finished_.count(next) || (input_done_ && next == num_batches_); });
+          if (!finished_.count(next)) return;
+          batch = std::move(finished_[next]);
+          finished_.erase(next);
+        }
+        out_ << batch->output << std::flush;
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+        space_.notify_one();
+      }
+    }
+
+    std::ostream& out_;
+    const size_t max_in_flight_;
+    std::mutex mutex_;
+    std::condition_variable work_, done_, space_;
+    std::deque<std::unique_ptr<Batch>> todo_;
+    std::map<uint64_t, std::unique_ptr<Batch>> finished_;
+    size_t in_flight_{0};
+    uint64_t num_batches_{0};
+    bool input_done_{false};
+    std::atomic<uint64_t> nodes_{0};
+    std::vector<std::thread> workers_;
+    std::thread writer_;
+  };
+
+  /**
+   * @brief Analyzes every line of the input.
+   */
+  inline Summary Run(std::istream& in, std::ostream& out, const unsigned num_threads) {
+    const auto start = std::chrono::steady_clock::now();
+    Summary summary;
+    Pipeline pipeline(out, num_threads);
+    auto batch = std::make_unique<Batch>();
+    std::string line;
+    while (std::getline(in, line)) {
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      if (line.empty()) continue;
+      batch->lines.push_back(line);
+      ++summary.positions;
+      if (batch->lines.size() < kBatchSize) continue;
+      batch->index = (summary.positions - 1) / kBatchSize;
+      pipeline.Push(std::move(batch));
+      batch = std::make_unique<Batch>();
+    }
+    if (!batch->lines.empty()) {
+      batch->index = (summary.positions - 1) / kBatchSize;
+      pipeline.Push(std::move(batch));
+    }
+    summary.nodes = pipeline.Finish();
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+  }
+}
+
+#endif // CONNECT_FOUR_ANALYSIS_H
@@ -0,0 +1,166 @@
+#ifndef CONNECT_FOUR_BITBOARD_H
+#define CONNECT_FOUR_BITBOARD_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "connect_four_rules.h"
+
+/**
+ * @brief A Connect Four position in two 64-bit words.
+ *
+ * Each column takes 7 bits, bit `col * 7 + height` from the bottom, the 7th
+ * bit of a column stays empty so shifts never carry from one column into the
+ * next. `mask` has every stone, `current` the stones of the player to move.
+ */
+struct Bitboard {
+  static constexpr int kHeight{rows}, kWidth{cols}, kColumnBits{rows + 1};
+  static constexpr uint64_t kBottom{0x40810204081ULL}; // The bottom cell of every column.
+  static constexpr uint64_t kBoard{kBottom * ((1ULL << rows) - 1)};
+
+  uint64_t current{0};
+  uint64_t mask{0};
+  int moves{0};
+
+  static constexpr uint64_t BottomMask(const int col) { return 1ULL << (col * kColumnBits); }
+  static constexpr uint64_t TopMask(const int col) { return 1ULL << (kHeight - 1 + col * kColumnBits); }
+  static constexpr uint64_t ColumnMask(const int col) { return ((1ULL << kHeight) - 1) << (col * kColumnBits); }
+
+  /**
+   * @brief Whether the stones contain four in a row.
+   */
+  static bool HasFour(const uint64_t stones) {
+    // Horizontal, diagonal /, diagonal \ and vertical neighbours are 7, 8, 6 and 1 bits away
+    for (const int shift : {kColumnBits, kColumnBits + 1, kColumnBits - 1, 1}) {
+      const uint64_t pairs{stones & (stones >> shift)};
+      if (pairs & (pairs >> (2 * shift))) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief The position of a grid of the game.
+   *
+   * @param to_move The color of the player to move.
+   */
+  static Bitboard FromGrid(const std::vector<std::vector<Connect>>& grid, const Connect to_move) {
+    Bitboard position;
+    for (int i{0}; i < rows; ++i) {
+      for (int j{0}; j < cols; ++j) {
+        if (grid[i][j] == empty) continue;
+        const uint64_t bit{1ULL << (j * kColumnBits + rows - 1 - i)};
+        position.mask |= bit;
+        if (grid[i][j] == to_move) position.current |= bit;
+        ++position.moves;
+      }
+    }
+    return position;
+  }
+
+  /**
+   * @brief The position after a sequence of columns, numbered from 1.
+   *
+   * @return False if a move is not a column, is played in a full column or
+   *         follows a win.
+   */
+  static bool FromMoves(const std::string& moves, Bitboard& position) {
+    position = Bitboard{};
+    for (const char move : moves) {
+      const int col{move - '1'};
+      if (col < 0 || col >= kWidth || !position.CanPlay(col) || position.IsWinningMove(col)) return false;
+      position.Play(col);
+    }
+    return true;
+  }
+
+  bool CanPlay(const int col) const { return (mask & TopMask(col)) == 0; }
+
+  void Play(const int col) {
+    current ^= mask;
+    mask |= mask + BottomMask(col);
+    ++moves;
+  }
+
+  /**
+   * @brief Whether playing the column connects four for the player to move.
+   */
+  bool IsWinningMove(const int col) const {
+    return HasFour(current | ((mask + BottomMask(col)) & ColumnMask(col)));
+  }
+
+  int NumEmpty() const { return kWidth * kHeight - moves; }
+
+  /**
+   * @brief The empty cells that would connect four for the owner of `stones`.
+   */
+  static uint64_t WinningCells(const uint64_t stones, const uint64_t mask) {
+    uint64_t cells{(stones << 1) & (stones << 2) & (stones << 3)};
+    // Three in a line with the cell at either end or in one of the two gaps
+    for (const int shift : {kColumnBits, kColumnBits - 1, kColumnBits + 1}) {
+      uint64_t pair{(stones << shift) & (stones << 2 * shift)};
+      cells |= pair & (stones << 3 * shift);
+      cells |= pair & (stones >> shift);
+      pair = (stones >> shift) & (stones >> 2 * shift);
+      cells |= pair & (stones << shift);
+      cells |= pair & (stones >> 3 * shift);
+    }
+    return cells & (kBoard ^ mask);
+  }
+
+  // The cell every column would be played in
+  uint64_t Possible() const { return (mask + kBottom) & kBoard; }
+
+  bool CanWinNext() const { return WinningCells(current, mask) & Possible(); }
+
+  /**
+   * @brief The moves that do not let the opponent win at once.
+   *
+   * A cell the opponent needs must be blocked and the cell below it left
+   * empty; two such cells to block lose anyway, so there is no move.
+   */
+  uint64_t NonLosingMoves() const {
+    uint64_t possible{Possible()};
+    const uint64_t opponent_wins{WinningCells(current ^ mask, mask)};
+    const uint64_t forced{possible & opponent_wins};
+    if (forced) {
+      if (forced & (forced - 1)) return 0;
+      possible = forced;
+    }
+    return possible & ~(opponent_wins >> 1);
+  }
+
+  /**
+   * @brief How many winning cells a move creates, to try the best moves first.
+   */
+  int MoveScore(const uint64_t move) const { return __builtin_popcountll(WinningCells(current | move, mask)); }
+
+  // Plays the cell of a move from `Possible`
+  void PlayCell(const uint64_t move) {
+    current ^= mask;
+    mask |= move;
+    ++moves;
+  }
+
+  // Tells every position apart, the carry of the addition stays in the column
+  uint64_t Key() const { return current + mask; }
+
+  static uint64_t Mirror(const uint64_t board) {
+    uint64_t mirrored{0};
+    for (int col{0}; col < kWidth; ++col)
+      mirrored |= ((board >> (col * kColumnBits)) & 0x7F) << ((kWidth - 1 - col) * kColumnBits);
+    return mirrored;
+  }
+
+  /**
+   * @brief The position or its mirror image, whichever has the smaller key.
+   *
+   * Both have the same value, so tables keep only this one.
+   */
+  Bitboard Canonical() const {
+    if (Mirror(Key()) >= Key()) return *this;
+    return {Mirror(current), Mirror(mask), moves};
+  }
+};
+
+#endif // CONNECT_FOUR_BITBOARD_H
@@ -0,0 +1,332 @@
+#ifndef CONNECT_FOUR_ENDGAME_H
+#define CONNECT_FOUR_ENDGAME_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "connect_four_bitboard.h"
+
+/**
+ * Exact values of late Connect Four positions, solved backwards from seed
+ * positions: offline by build_endgame and read through a memory mapping, or
+ * by the game from its own position and kept in memory.
+ *
+ * The file holds the canonical positions sorted by key. A key is 49 bits:
+ * its top 17 bits pick a bucket of the offset table and only the low 32 bits
+ * are stored, next to a one byte value, so a position takes 5 bytes and a
+ * probe is an offset read plus a binary search within its bucket.
+ */
+namespace Endgame {
+  enum Result : uint8_t { loss, draw, win };
+
+  /**
+   * @brief The outcome for the player to move with perfect play, and how many
+   *        moves are left until the game ends.
+   */
+  struct Value {
+    Result result;
+    int distance;
+
+    uint8_t Encode() const { return static_cast<uint8_t>(result | distance << 2); }
+    static Value Decode(const uint8_t byte) { return {static_cast<Result>(byte & 3), byte >> 2}; }
+
+    /**
+     * @brief The value of the parent position, for the player who moved into this one.
+     */
+    Value Parent() const { return {static_cast<Result>(win - result), distance + 1}; }
+
+    /**
+     * @brief Whether this value is better for the player to move: quicker wins,
+     *        then draws, then slower losses.
+     */
+    bool Beats(const Value& other) const {
+      if (result != other.result) return result > other.result;
+      return result == win ? distance < other.distance : distance > other.distance;
+    }
+  };
+
+  const uint64_t kMagic{0x3142444e45344643}; // "CF4ENDB1"
+  const int kLowBits{32};
+  const int kBucketBits{Bitboard::kWidth * Bitboard::kColumnBits - kLowBits};
+
+  struct Header {
+    uint64_t magic;
+    uint32_t max_empty;     // Every stored position has at most this many empty cells.
+    uint32_t bucket_bits;
+    uint64_t num_positions;
+  };
+
+  // The canonical positions of a layer, sorted by key
+  using Layer = std::vector<Bitboard>;
+
+  struct Positions {
+    std::vector<Bitboard> positions;
+
+    void Merge(Positions& other) {
+      positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+    }
+  };
+
+  inline void SortUnique(Layer& layer) {
+    const auto by_key = [](const Bitboard& a, const Bitboard& b) { return a.Key() < b.Key(); };
+    const auto same_key = [](const Bitboard& a, const Bitboard& b) { return a.Key() == b.Key(); };
+    std::sort(layer.begin(), layer.end(), by_key);
+    layer.erase(std::unique(layer.begin(), layer.end(), same_key), layer.end());
+  }
+
+  inline bool HasWinningMove(const Bitboard& position) {
+    for (int col{0}; col < Bitboard::kWidth; ++col)
+      if (position.CanPlay(col) && position.IsWinningMove(col)) return true;
+    return false;
+  }
+
+  /**
+   * @brief The positions after every move of a layer that neither wins nor
+   *        lets the opponent win at once, those are valued without a child.
+   */
+  inline Layer Children(const Layer& layer) {
+    Positions children{Parallel::Accumulate<Positions>(layer.size(), [&layer](Positions& out, const uint64_t begin,
+                                                                              const uint64_t end, unsigned) {
+      for (uint64_t i{begin}; i < end; ++i) {
+        if (HasWinningMove(layer[i])) continue;
+        const uint64_t non_losing{layer[i].NonLosingMoves()};
+        for (int col{0}; col < Bitboard::kWidth; ++col) {
+          if (!(non_losing & Bitboard::ColumnMask(col))) continue;
+          Bitboard child{layer[i]};
+          child.Play(col);
+          out.positions.push_back(child.Canonical());
+        }
+      }
+    })};
+    SortUnique(children.positions);
+    return std::move(children.positions);
+  }
+
+  struct Nothing {
+    void Merge(const Nothing&) {}
+  };
+
+  /**
+   * @brief The values of a layer, given the values of the layer below.
+   */
+  inline std::vector<uint8_t> SolveLayer(const Layer& layer, const Layer& below,
+                                         const std::vector<uint8_t>& below_values) {
+    std::vector<uint8_t> values(layer.size());
+    Parallel::Accumulate<Nothing>(layer.size(), [&](Nothing&, const uint64_t begin, const uint64_t end, unsigned) {
+      for (uint64_t i{begin}; i < end; ++i) {
+        const Bitboard& position{layer[i]};
+        Value best{draw, 0};
+        if (HasWinningMove(position)) {
+          best = {win, 1};
+        } else if (position.NumEmpty() > 0) {
+          // A move that lets the opponent win at once loses in two
+          const uint64_t non_losing{position.NonLosingMoves()};
+          best = {loss, 2};
+          for (int col{0}; col < Bitboard::kWidth; ++col) {
+            if (!(non_losing & Bitboard::ColumnMask(col))) continue;
+            Bitboard child{position};
+            child.Play(col);
+            const uint64_t key{child.Canonical().Key()};
+            const auto found = std::lower_bound(below.begin(), below.end(), key,
+                                                [](const Bitboard& a, const uint64_t k) { return a.Key() < k; });
+            const Value value{Value::Decode(below_values[found - below.begin()]).Parent()};
+            if (value.Beats(best)) best = value;
+          }
+        }
+        values[i] = best.Encode();
+      }
+    });
+    return values;
+  }
+
+  /**
+   * @brief Solves every position reachable from the seeds, enumerated layer
+   *        by layer down to the full board, then valued from the full board
+   *        back up, each layer reading the values of the one below.
+   *
+   * @param seeds Canonical positions with `num_empty` empty cells.
+   * @return The canonical keys and their values, sorted by key.
+   */
+  inline std::vector<std::pair<uint64_t, uint8_t>> Build(Layer seeds, const int num_empty) {
+    std::vector<Layer> layers(num_empty + 1);
+    layers[num_empty] = std::move(seeds);
+    SortUnique(layers[num_empty]);
+    uint64_t total{layers[num_empty].size()};
+    for (int e{num_empty}; e > 0; --e) {
+      layers[e - 1] = Children(layers[e]);
+      total += layers[e - 1].size();
+    }
+    std::vector<std::pair<uint64_t, uint8_t>> entries;
+    entries.reserve(total);
+    std::vector<uint8_t> below_values;
+    for (int e{0}; e <= num_empty; ++e) {
+      std::vector<uint8_t> values{SolveLayer(layers[e], e > 0 ? layers[e - 1] : Layer{}, below_values)};
+      for (size_t i{0}; i < layers[e].size(); ++i) entries.emplace_back(layers[e][i].Key(), values[i]);
+      below_values = std::move(values);
+      if (e > 0) Layer{}.swap(layers[e - 1]);
+    }
+    std::sort(entries.begin(), entries.end());
+    return entries;
+  }
+
+  /**
+   * @brief Writes a table of canonical keys and their values, sorted by key.
+   *
+   * @return True on success, false if the file could not be written.
+   */
+  inline bool Write(const std::string& file_name, const std::vector<std::pair<uint64_t, uint8_t>>& entries,
+                    const int max_empty) {
+    const Header header{kMagic, static_cast<uint32_t>(max_empty), static_cast<uint32_t>(kBucketBits),
+                        entries.size()};
+    std::vector<uint32_t> offsets((1ULL << kBucketBits) + 1, 0), low_keys(entries.size());
+    std::vector<uint8_t> values(entries.size());
+    for (size_t i{0}; i < entries.size(); ++i) {
+      ++offsets[(entries[i].first >> kLowBits) + 1];
+      low_keys[i] = static_cast<uint32_t>(entries[i].first);
+      values[i] = entries[i].second;
+    }
+    for (size_t b{1}; b < offsets.size(); ++b) offsets[b] += offsets[b - 1];
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(low_keys.data()), low_keys.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(values.data()), values.size());
+    return static_cast<bool>(file);
+  }
+
+  class Table {
+   public:
+    Table() = default;
+    Table(const Table&) = delete;
+    Table& operator=(const Table&) = delete;
+
+    ~Table() {
+      if (data_) munmap(data_, size_);
+    }
+
+    /**
+     * @brief Holds a table built in memory by `Build`, instead of a file.
+     */
+    void Assign(std::vector<std::pair<uint64_t, uint8_t>> entries, const int max_empty) {
+      if (data_) munmap(data_, size_);
+      data_ = nullptr;
+      entries_ = std::move(entries);
+      max_empty_ = max_empty;
+      num_positions_ = entries_.size();
+    }
+
+    /**
+     * @brief Maps a table written by `Write`.
+     *
+     * @return True on success, false if the file is missing or not a table.
+     */
+    bool Load(const std::string& file_name) {
+      const int fd{open(file_name.c_str(), O_RDONLY | O_CLOEXEC)};
+      if (fd < 0) return false;
+      struct stat file_stat;
+      void* data{MAP_FAILED};
+      if (fstat(fd, &file_stat) == 0 && file_stat.st_size >= static_cast<off_t>(sizeof(Header)))
+        data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED) return false;
+      const Header* header{static_cast<const Header*>(data)};
+      const uint64_t num_buckets{1ULL << kBucketBits};
+      if (header->magic != kMagic || header->bucket_bits != kBucketBits ||
+          static_cast<uint64_t>(file_stat.st_size) !=
+              sizeof(Header) + (num_buckets + 1) * sizeof(uint32_t) + header->num_positions * 5) {
+        munmap(data, file_stat.st_size);
+        return false;
+      }
+      if (data_) munmap(data_, size_);
+      std::vector<std::pair<uint64_t, uint8_t>>().swap(entries_);
+      data_ = data;
+      size_ = file_stat.st_size;
+      max_empty_ = header->max_empty;
+      offsets_ = reinterpret_cast<const uint32_t*>(header + 1);
+      low_keys_ = offsets_ + num_buckets + 1;
+      values_ = reinterpret_cast<const uint8_t*>(low_keys_ + header->num_positions);
+      num_positions_ = header->num_positions;
+      return true;
+    }
+
+    bool IsLoaded() const { return data_ != nullptr || !entries_.empty(); }
+    int MaxEmpty() const { return max_empty_; }
+    uint64_t NumPositions() const { return num_positions_; }
+
+    /**
+     * @brief Looks a position up.
+     *
+     * @return True if the position is in the table, its value is then set.
+     */
+    bool Probe(const Bitboard& position, Value& value) const {
+      if (!IsLoaded() || position.NumEmpty() > max_empty_) return false;
+      const uint64_t key{position.Canonical().Key()};
+      if (!data_) {
+        const auto found = std::lower_bound(entries_.begin(), entries_.end(), std::make_pair(key, uint8_t{0}));
+        if (found == entries_.end() || found->first != key) return false;
+        value = Value::Decode(found->second);
+        return true;
+      }
+      const uint64_t bucket{key >> kLowBits};
+      const uint32_t low{static_cast<uint32_t>(key)};
+      const uint32_t* begin{low_keys_ + offsets_[bucket]};
+      const uint32_t* end{low_keys_ + offsets_[bucket + 1]};
+      const uint32_t* found{std::lower_bound(begin, end, low)};
+      if (found == end || *found != low) return false;
+      value = Value::Decode(values_[found - low_keys_]);
+      return true;
+    }
+
+   private:
+    void* data_{nullptr};
+    size_t size_{0};
+    int max_empty_{0};
+    const uint32_t* offsets_{nullptr};
+    const uint32_t* low_keys_{nullptr};
+    const uint8_t* values_{nullptr};
+    uint64_t num_positions_{0};
+    std::vector<std::pair<uint64_t, uint8_t>> entries_; // A table built in memory.
+  };
+
+  /**
+   * @brief The best column of a position, read from the table without search.
+   *
+   * @return The column, -1 if a position after one of the moves is not in the table.
+   */
+  inline int BestColumn(const Table& table, const Bitboard& position) {
+    // Central columns first, they win ties
+    const int order[Bitboard::kWidth]{3, 2, 4, 1, 5, 0, 6};
+    for (const int col : order)
+      if (position.CanPlay(col) && position.IsWinningMove(col)) return col;
+    int best_col{-1};
+    Value best{loss, 0};
+    for (const int col : order) {
+      if (!position.CanPlay(col)) continue;
+      Bitboard child{position};
+      child.Play(col);
+      Value value;
+      // Neither a full board nor a move the opponent wins after is stored
+      if (child.NumEmpty() == 0) value = {draw, 0};
+      else if (child.CanWinNext()) value = {win, 1};
+      else if (!table.Probe(child, value)) return -1;
+      value = value.Parent();
+      if (best_col < 0 || value.Beats(best)) {
+        best_col = col;
+        best = value;
+      }
+    }
+    return best_col;
+  }
+}
+
+#endif // CONNECT_FOUR_ENDGAME_H
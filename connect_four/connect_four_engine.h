@@ -0,0 +1,70 @@
+#ifndef CONNECT_FOUR_ENGINE_H
+#define CONNECT_FOUR_ENGINE_H
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "connect_four_bitboard.h"
+#include "connect_four_rules.h"
+
+/**
+ * @brief Connect Four for the headless engine, yellow (the user) plays first.
+ */
+struct ConnectFourGame {
+  // A bitboard, so the state has a fixed size and copying it is cheap
+  struct State {
+    Bitboard board;
+    int winner; // -1 while nobody has connected four.
+  };
+  using Action = int; // The column (0-based).
+  static constexpr int kNumPlayers{2};
+
+  State Initial(std::mt19937&) const { return {Bitboard{}, -1}; }
+
+  // Yellow moves on even turns
+  int CurrentPlayer(const State& state) const { return state.board.moves % 2; }
+
+  void LegalActions(const State& state, std::vector<Action>& actions) const {
+    actions.clear();
+    for (int col{0}; col < cols; ++col)
+      if (state.board.CanPlay(col)) actions.push_back(col);
+  }
+
+  State Apply(State state, const Action& col) const {
+    if (state.board.IsWinningMove(col)) state.winner = CurrentPlayer(state);
+    state.board.Play(col);
+    return state;
+  }
+
+  bool IsTerminal(const State& state) const { return state.winner != -1 || state.board.NumEmpty() == 0; }
+
+  double Outcome(const State& state, const int player) const {
+    if (state.winner == -1) return 0.5;
+    return state.winner == player ? 1 : 0;
+  }
+
+  std::string Render(const State& state) const {
+    // `current` holds the stones of the player to move
+    const char to_move{CurrentPlayer(state) == 0 ? 'Y' : 'R'}, other{CurrentPlayer(state) == 0 ? 'R' : 'Y'};
+    std::string text;
+    for (int i{0}; i < rows; ++i) {
+      for (int col{0}; col < cols; ++col) {
+        const uint64_t bit{1ULL << (col * Bitboard::kColumnBits + rows - 1 - i)};
+        text += !(state.board.mask & bit) ? '.' : state.board.current & bit ? to_move : other;
+      }
+      text += '\n';
+    }
+    return text;
+  }
+
+  std::string ActionName(const Action& col) const { return std::to_string(col + 1); }
+
+  bool ParseAction(const std::string& text, Action& col) const {
+    if (text.size() != 1 || text[0] < '1' || text[0] >= '1' + cols) return false;
+    col = text[0] - '1';
+    return true;
+  }
+};
+
+#endif // CONNECT_FOUR_ENGINE_H
@@ -0,0 +1,49 @@
+#ifndef CONNECT_FOUR_RULES_H
+#define CONNECT_FOUR_RULES_H
+
+#include <vector>
+
+const int rows{6}, cols{7};
+
+enum Connect {
+  empty,
+  yellow,
+  red
+};
+
+inline bool IsGridFull(const std::vector<std::vector<Connect>>& grid) {
+  for (const auto& row : grid)
+    for (const auto& connect : row)
+      if (connect == empty) return false;
+  return true;
+}
+
+inline bool CheckWin(const std::vector<std::vector<Connect>>& grid) {
+  // Check rows
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols - 3; ++j)
+      if (grid[i][j] != empty && grid[i][j] == grid[i][j + 1] && 
+          grid[i][j] == grid[i][j + 2] && grid[i][j] == grid[i][j + 3])
+        return true;
+  // Check columns
+  for (int i = 0; i < rows - 3; ++i)
+    for (int j = 0; j < cols; ++j)
+      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j] && 
+          grid[i][j] == grid[i + 2][j] && grid[i][j] == grid[i + 3][j])
+        return true;
+  // Check diagonals (top-left to bottom-right)
+  for (int i = 0; i < rows - 3; ++i)
+    for (int j = 0; j < cols - 3; ++j)
+      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j + 1] && 
+          grid[i][j] == grid[i + 2][j + 2] && grid[i][j] == grid[i + 3][j + 3])
+        return true;
+  // Check diagonals (top-right to bottom-left)
+  for (int i = 0; i < rows - 3; ++i)
+    for (int j = 3; j < cols; ++j)
+      if (grid[i][j] != empty && grid[i][j] == grid[i + 1][j - 1] && 
+          grid[i][j] == grid[i + 2][j - 2] && grid[i][j] == grid[i + 3][j - 3])
+        return true;
+  return false;
+}
+
+#endif // CONNECT_FOUR_RULES_H
@@ -0,0 +1,135 @@
+#ifndef CONNECT_FOUR_SOLVER_H
+#define CONNECT_FOUR_SOLVER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "connect_four_bitboard.h"
+
+/**
+ * @brief Exact Connect Four solver: alpha-beta negamax on bitboards.
+ *
+ * The score of a position is for the player to move: 0 for a draw, the number
+ * of stones the winner has left when winning, negative when losing, so
+ * quicker wins score higher. The solver keeps its transposition table between
+ * positions, so solving many positions of the same games gets faster.
+ */
+class Solver {
+ public:
+  static constexpr int kCells{Bitboard::kWidth * Bitboard::kHeight};
+  static constexpr int kMinScore{-kCells / 2 + 3}, kMaxScore{(kCells + 1) / 2 - 3};
+
+  // A prime a little above 2^23: with 32 bit keys stored, keys below 2^55 stay unique
+  explicit Solver(const uint64_t table_size = 8388617) : keys_(table_size, 0), values_(table_size, 0) {}
+
+  /**
+   * @brief The exact score of a position where nobody has connected four.
+   */
+  int Solve(const Bitboard& position) {
+    if (position.CanWinNext()) return (kCells + 1 - position.moves) / 2;
+    int min{-(kCells - position.moves) / 2}, max{(kCells + 1 - position.moves) / 2};
+    // Null window searches, probing near 0 first where most scores are
+    while (min < max) {
+      int middle{min + (max - min) / 2};
+      if (middle <= 0 && min / 2 < middle) middle = min / 2;
+      else if (middle >= 0 && max / 2 > middle) middle = max / 2;
+      const int score{Negamax(position, middle, middle + 1)};
+      if (score <= middle) max = score;
+      else min = score;
+    }
+    return min;
+  }
+
+  static constexpr int kInvalid{-1000};
+
+  /**
+   * @brief The score of playing each column, `kInvalid` for the full ones.
+   */
+  std::vector<int> Analyze(const Bitboard& position) {
+    std::vector<int> scores(Bitboard::kWidth, kInvalid);
+    for (int col{0}; col < Bitboard::kWidth; ++col) {
+      if (!position.CanPlay(col)) continue;
+      if (position.IsWinningMove(col)) {
+        scores[col] = (kCells + 1 - position.moves) / 2;
+        continue;
+      }
+      Bitboard child{position};
+      child.Play(col);
+      scores[col] = -Solve(child);
+    }
+    return scores;
+  }
+
+  /**
+   * @brief The column with the best score, central columns winning ties.
+   */
+  int BestColumn(const Bitboard& position) {
+    const std::vector<int> scores{Analyze(position)};
+    int best{-1};
+    for (const int col : {3, 2, 4, 1, 5, 0, 6})
+      if (scores[col] != kInvalid && (best < 0 || scores[col] > scores[best])) best = col;
+    return best;
+  }
+
+  uint64_t NumNodes() const { return num_nodes_; }
+
+ private:
+  /**
+   * @brief The score within the window (alpha, beta), or a bound outside it.
+   *
+   * The player to move cannot win at once, the caller checked.
+   */
+  int Negamax(const Bitboard& position, int alpha, int beta) {
+    ++num_nodes_;
+    const uint64_t possible{position.NonLosingMoves()};
+    if (possible == 0) return -(kCells - position.moves) / 2;
+    if (position.moves >= kCells - 2) return 0;
+    const int min{-(kCells - 2 - position.moves) / 2};
+    if (alpha < min) {
+      alpha = min;
+      if (alpha >= beta) return alpha;
+    }
+    int max{(kCells - 1 - position.moves) / 2};
+    const uint64_t key{position.Key()};
+    const uint64_t slot{key % keys_.size()};
+    if (keys_[slot] == static_cast<uint32_t>(key) && values_[slot]) max = values_[slot] + kMinScore - 1;
+    if (beta > max) {
+      beta = max;
+      if (alpha >= beta) return beta;
+    }
+    // Moves creating the most threats first, central columns first among equals
+    uint64_t moves[Bitboard::kWidth];
+    int scores[Bitboard::kWidth];
+    int num_moves{0};
+    for (const int col : {6, 0, 5, 1, 4, 2, 3}) {
+      const uint64_t move{possible & Bitboard::ColumnMask(col)};
+      if (!move) continue;
+      const int score{position.MoveScore(move)};
+      int i{num_moves++};
+      for (; i > 0 && scores[i - 1] > score; --i) {
+        moves[i] = moves[i - 1];
+        scores[i] = scores[i - 1];
+      }
+      moves[i] = move;
+      scores[i] = score;
+    }
+    for (int i{num_moves - 1}; i >= 0; --i) {
+      Bitboard child{position};
+      child.PlayCell(moves[i]);
+      const int score{-Negamax(child, -beta, -alpha)};
+      if (score >= beta) return score;
+      if (score > alpha) alpha = score;
+    }
+    // An upper bound, stored shifted so 0 means an empty slot
+    keys_[slot] = static_cast<uint32_t>(key);
+    values_[slot] = static_cast<uint8_t>(alpha - kMinScore + 1);
+    return alpha;
+  }
+
+  std::vector<uint32_t> keys_;
+  std::vector<uint8_t> values_;
+  uint64_t num_nodes_{0};
+};
+
+#endif // CONNECT_FOUR_SOLVER_H
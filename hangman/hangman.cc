@@ -1,66 +1,23 @@
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <random>
 #include <sstream>
 #include <string>
 
-#include "system_clear_screen.h"
+#include "../common/keyboard.h"
+#include "../common/latency.h"
+#include "../common/stats_store.h"
+#include "../common/terminal.h"
+#include "../common/word_file.h"
 
-const int win = true;
-
-// Initialize the random generator once
-std::mt19937 generator(std::random_device{}());
-
-/**
- * @brief Generate a random integer between min and max (inclusive).
- *
- * @param min The minimum value of the random number.
- * @param max The maximum value of the random number.
- * @return A random integer between min and max.
- */
-int GetRandomNum(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
-}
-
-/**
- * @brief Count the number of lines in a file.
- * 
- * @param input_file_name The name of the input file.
- * @return The number of lines in the file. Returns 0 if the file cannot be opened.
- */
-inline int GetNumLinesFromFile(const std::string& input_file_name) {
-    std::ifstream input_file(input_file_name); 
-    if (!input_file.is_open()) return 0;
-    return std::count(std::istreambuf_iterator<char>(input_file),
-                      std::istreambuf_iterator<char>(), '\n');
-}
-
-/**
- * @brief Retrieve a random word from a file.
- * 
- * @param input_file_name The name of the input file.
- * @return A random word from the file, or an empty string if the file cannot be opened.
- */
-std::string RandomWordFromFile(const std::string& input_file_name) {
-  std::ifstream input_file(input_file_name); 
-  if (!input_file.is_open()) return "";
-  const int num_lines{GetNumLinesFromFile(input_file_name)};
-  const int target_line{GetRandomNum(0, num_lines)};
-  int currentLine{0};
-  std::string line;
-  while (std::getline(input_file, line)) {
-    if (++currentLine == target_line) break;
-  }
-  std::istringstream line_stream(line);
-  std::string word{};
-  // A line can have multiple words, so we get the first one
-  line_stream >> word;
-  input_file.close();
-  return word;
-}
+// Printed on exit with --stats
+Latency::Metric input_latency{"input"};
+Latency::Metric render_latency{"render"};
+Latency::Metric word_file_latency{"word file"};
 
+const int win = true;
 
 /**
  * @brief Prints the hangman figure based on the number of attempts remaining.
@@ -181,6 +138,7 @@ void PrintHangman(const int num_attemps) {
  * @param excluded_letters The letters that have been used but are not in the word.
  */
 void PrintGame(const std::string& guess_word, const std::string& excluded_letters) {
+  Latency::ScopedTimer timer(render_latency);
   // print letters used
   std::cout << " Not valid letters: ";
   for (int i = 0; !excluded_letters.empty() && i < excluded_letters.length() - 1; ++i) {
@@ -207,11 +165,17 @@ void PrintGame(const std::string& guess_word, const std::string& excluded_letter
  */
 bool GameRound(const std::string& input_file_name, int& num_attemps, const std::string& word, 
                std::string& guess_word, std::string& excluded_letters) {
-    std::cout << " Write a letter (press enter): ";
-    // Ask user
-    char guess_letter;
-    std::cin >> guess_letter;
-    guess_letter = toupper(guess_letter);
+    std::cout << " Write a letter: " << std::flush;
+    // Ask user, the letter is taken as soon as it is pressed
+    Keyboard::Key key{Latency::Time(input_latency, [] {
+      Keyboard::Key key{Keyboard::input.Read()};
+      while (key.code != Keyboard::character || isspace(key.ch)) {
+        if (key.code == Keyboard::end_of_input) std::exit(0);
+        key = Keyboard::input.Read();
+      }
+      return key;
+    })};
+    char guess_letter = toupper(key.ch);
     Console::ClearScreen();
     // Check if its a letter
     if (!isalpha(guess_letter)) {
@@ -248,10 +212,10 @@ bool GameRound(const std::string& input_file_name, int& num_attemps, const std::
 bool Game(const std::string& vocabulary_file_name) {
   int num_attemps = 9;
   // Gets the word from the file
-  std::string generated_word = RandomWordFromFile(vocabulary_file_name);
+  std::string generated_word = Latency::Time(word_file_latency, [&] { return RandomWordFromFile(vocabulary_file_name); });
   if (generated_word.empty()) {
     std::cerr << "There was an error trying to get the word\n";
-    return 1;
+    exit(EXIT_FAILURE);
   }
   for (auto& c : generated_word) c = toupper(c);
   // The `guess_word` characters are replaced with the word's characters if the
@@ -270,7 +234,10 @@ bool Game(const std::string& vocabulary_file_name) {
   return !win;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+  Latency::ParseFlag(argc, argv);
   const std::string vocabulary_file_name = "hangman_en.txt";
-  std::cout << (Game(vocabulary_file_name) == win ? "Congratulations! You won!" : "Game over!") << std::endl;
+  const bool won{Game(vocabulary_file_name) == win};
+  std::cout << (won ? "Congratulations! You won!" : "Game over!") << std::endl;
+  Stats::RecordResult(Stats::Game::hangman, won ? Stats::Outcome::win : Stats::Outcome::loss);
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef HANGMAN_ENGINE_H
+#define HANGMAN_ENGINE_H
+
+#include <array>
+#include <cctype>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/engine.h"
+
+/**
+ * @brief Hangman for the headless engine, a single player guesses letters.
+ */
+class HangmanGame {
+ public:
+  struct State {
+    std::string word;             // The word to guess, in uppercase.
+    std::string guess_word;       // The word with '_' for every letter not found yet.
+    std::string excluded_letters; // The letters tried that are not in the word.
+  };
+  using Action = char; // An uppercase letter.
+  static constexpr int kNumPlayers{1};
+  static constexpr int kNumAttempts{9}; // Wrong letters allowed.
+
+  explicit HangmanGame(std::vector<std::string> words) : words_(std::move(words)) {
+    for (auto& word : words_)
+      for (auto& c : word) c = toupper(c);
+  }
+
+  const std::vector<std::string>& Words() const { return words_; }
+
+  State Initial(std::mt19937& generator) const {
+    const std::string& word = words_[std::uniform_int_distribution<size_t>(0, words_.size() - 1)(generator)];
+    return {word, std::string(word.length(), '_'), ""};
+  }
+
+  int CurrentPlayer(const State&) const { return 0; }
+
+  void LegalActions(const State& state, std::vector<Action>& actions) const {
+    actions.clear();
+    for (char letter{'A'}; letter <= 'Z'; ++letter)
+      if (!IsTried(state, letter)) actions.push_back(letter);
+  }
+
+  State Apply(State state, const Action& letter) const {
+    bool in_word{false};
+    for (size_t i{0}; i < state.word.length(); ++i) {
+      if (state.word[i] == letter) {
+        state.guess_word[i] = letter;
+        in_word = true;
+      }
+    }
+    if (!in_word) state.excluded_letters += letter;
+    return state;
+  }
+
+  bool IsTerminal(const State& state) const {
+    return state.guess_word == state.word || static_cast<int>(state.excluded_letters.size()) >= kNumAttempts;
+  }
+
+  double Outcome(const State& state, int) const { return state.guess_word == state.word ? 1 : 0; }
+
+  std::string Render(const State& state) const { return state.guess_word + "  [" + state.excluded_letters + "]\n"; }
+
+  std::string ActionName(const Action& letter) const { return std::string(1, letter); }
+
+  bool ParseAction(const std::string& text, Action& letter) const {
+    if (text.size() != 1 || !isalpha(static_cast<unsigned char>(text[0]))) return false;
+    letter = toupper(text[0]);
+    return true;
+  }
+
+  static bool IsTried(const State& state, const char letter) {
+    return state.excluded_letters.find(letter) != std::string::npos ||
+           state.guess_word.find(letter) != std::string::npos;
+  }
+
+ private:
+  std::vector<std::string> words_;
+};
+
+/**
+ * @brief Guesses the untried letter found in most of the words that still fit.
+ */
+class LetterFrequencyAgent : public Engine::Agent<HangmanGame> {
+ public:
+  char Act(const HangmanGame& game, const HangmanGame::State& state, std::mt19937& generator) override {
+    std::array<int, 26> counts{};
+    for (const std::string& word : game.Words()) {
+      if (!Fits(word, state)) continue;
+      std::array<bool, 26> seen{};
+      for (const char c : word)
+        if (isupper(static_cast<unsigned char>(c))) seen[c - 'A'] = true;
+      for (int letter{0}; letter < 26; ++letter) counts[letter] += seen[letter];
+    }
+    game.LegalActions(state, actions_);
+    char best{actions_[std::uniform_int_distribution<size_t>(0, actions_.size() - 1)(generator)]};
+    for (const char letter : actions_)
+      if (counts[letter - 'A'] > counts[best - 'A']) best = letter;
+    return best;
+  }
+
+ private:
+  // The word shows the found letters in the same places and none of the excluded ones
+  static bool Fits(const std::string& word, const HangmanGame::State& state) {
+    if (word.length() != state.guess_word.length()) return false;
+    for (size_t i{0}; i < word.length(); ++i) {
+      if (state.guess_word[i] == '_' ? HangmanGame::IsTried(state, word[i]) : word[i] != state.guess_word[i])
+        return false;
+    }
+    return true;
+  }
+
+  std::vector<char> actions_;
+};
+
+#endif // HANGMAN_ENGINE_H
@@ -0,0 +1,26 @@
+#ifndef HANOI_SOLVER_H
+#define HANOI_SOLVER_H
+
+#include <vector>
+
+/**
+ * @brief Moves a tower of disks from `source` to `target`.
+ *
+ * @param number_of_disks The number of disks on top of `source` to move.
+ * @param source The peg the disks start on.
+ * @param auxiliary The spare peg.
+ * @param target The peg the disks end on.
+ * @param on_move Called after every move with the pegs of that move, in the same order.
+ */
+template<typename OnMove>
+void move(const unsigned number_of_disks, std::vector<unsigned>& source, 
+          std::vector<unsigned>& auxiliary, std::vector<unsigned>& target, const OnMove& on_move) {
+  if (number_of_disks <= 0) return;
+  move(number_of_disks - 1, source, target, auxiliary, on_move);
+  target.push_back(source[source.size() - 1]);
+  source.pop_back();
+  on_move(source, auxiliary, target);
+  move(number_of_disks - 1, auxiliary, source, target, on_move);
+}
+
+#endif // HANOI_SOLVER_H
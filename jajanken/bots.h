@@ -0,0 +1,158 @@
+#ifndef BOTS_H
+#define BOTS_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "pattern_predictor.h"
+#include "rps_engine.h"
+
+namespace Jajanken {
+  /**
+   * @brief A player of Jajanken that chooses a move every round.
+   *
+   * @tparam N The number of moves of the game.
+   */
+  template <int N>
+  class Bot {
+   public:
+    explicit Bot(const uint64_t seed) : random_(seed) {}
+    virtual ~Bot() = default;
+
+    /**
+     * @brief Chooses the move of the next round (0-based).
+     */
+    virtual int Choose() = 0;
+
+    /**
+     * @brief Learns from the round that just finished.
+     *
+     * @param own The move the bot played.
+     * @param opponent The move the opponent played.
+     */
+    virtual void Observe(const int own, const int opponent) {
+      (void)own;
+      (void)opponent;
+    }
+
+   protected:
+    int RandomMove() { return std::uniform_int_distribution<int>(0, N - 1)(random_); }
+
+    // The move that beats the given one, the next one in cyclic order
+    static int Beat(const int move) { return (move + 1) % N; }
+
+    std::mt19937 random_;
+  };
+
+  /**
+   * @brief Plays every move with the same probability, the unbeatable baseline.
+   */
+  template <int N>
+  class RandomBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override { return this->RandomMove(); }
+  };
+
+  /**
+   * @brief Always plays rock.
+   */
+  template <int N>
+  class RockBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override { return 0; }
+  };
+
+  /**
+   * @brief Plays every move in cyclic order.
+   */
+  template <int N>
+  class CyclerBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override { return next_ = (next_ + 1) % N; }
+
+   private:
+    int next_{0};
+  };
+
+  /**
+   * @brief Plays what would have beaten the last move of the opponent.
+   */
+  template <int N>
+  class BeatLastBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override { return last_ < 0 ? this->RandomMove() : this->Beat(last_); }
+    void Observe(const int, const int opponent) override { last_ = opponent; }
+
+   private:
+    int last_{-1};
+  };
+
+  /**
+   * @brief Plays what beats the most frequent move of the opponent.
+   */
+  template <int N>
+  class FrequencyBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override {
+      int most_frequent{this->RandomMove()};
+      for (int move{0}; move < N; ++move)
+        if (counts_[move] > counts_[most_frequent]) most_frequent = move;
+      return this->Beat(most_frequent);
+    }
+    void Observe(const int, const int opponent) override { ++counts_[opponent]; }
+
+   private:
+    std::array<uint64_t, N> counts_{};
+  };
+
+  /**
+   * @brief Plays the counter of what the pattern predictor expects from the opponent.
+   */
+  template <int N>
+  class PredictorBot : public Bot<N> {
+   public:
+    using Bot<N>::Bot;
+    int Choose() override {
+      return PatternPredictor<N>::CounterMove(predictor_.Predict(), Rules<N>::CheckWin, this->random_);
+    }
+    void Observe(const int own, const int opponent) override { predictor_.Update(opponent, own); }
+
+   private:
+    PatternPredictor<N> predictor_;
+  };
+
+  /**
+   * @brief A named way to build a bot from a seed.
+   */
+  template <int N>
+  struct BotFactory {
+    std::string name;
+    std::function<std::unique_ptr<Bot<N>>(uint64_t)> make;
+  };
+
+  /**
+   * @brief Every bot strategy that takes part in the tournament.
+   */
+  template <int N>
+  std::vector<BotFactory<N>> AllBots() {
+    return {
+        {"random", [](uint64_t seed) { return std::make_unique<RandomBot<N>>(seed); }},
+        {"rock", [](uint64_t seed) { return std::make_unique<RockBot<N>>(seed); }},
+        {"cycler", [](uint64_t seed) { return std::make_unique<CyclerBot<N>>(seed); }},
+        {"beat-last", [](uint64_t seed) { return std::make_unique<BeatLastBot<N>>(seed); }},
+        {"frequency", [](uint64_t seed) { return std::make_unique<FrequencyBot<N>>(seed); }},
+        {"predictor", [](uint64_t seed) { return std::make_unique<PredictorBot<N>>(seed); }},
+    };
+  }
+}
+
+#endif // BOTS_H
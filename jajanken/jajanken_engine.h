@@ -0,0 +1,118 @@
+#ifndef JAJANKEN_ENGINE_H
+#define JAJANKEN_ENGINE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/engine.h"
+#include "bots.h"
+#include "rps_engine.h"
+
+namespace Jajanken {
+  /**
+   * @brief A match of Jajanken for the headless engine, the first to win 3 rounds wins.
+   *
+   * Both players throw at once; the engine asks player 0 and then player 1,
+   * keeping the first throw in `pending`. Agents must not look at it.
+   *
+   * @tparam N The number of moves of the game.
+   */
+  template <int N>
+  struct Game {
+    // Ties can go on forever, only the last rounds are kept so the state has a fixed size
+    static constexpr int kRecentRounds{8};
+
+    struct State {
+      int wins[2];
+      int pending;         // The throw of player 0 in this round, -1 before it.
+      uint64_t num_rounds; // Finished rounds.
+      std::array<std::pair<int, int>, kRecentRounds> recent; // The throws of round r at r % kRecentRounds.
+
+      // The throws of a round among the last kRecentRounds
+      const std::pair<int, int>& Round(const uint64_t round) const { return recent[round % kRecentRounds]; }
+
+      uint64_t FirstRecent() const { return num_rounds < kRecentRounds ? 0 : num_rounds - kRecentRounds; }
+    };
+    using Action = int; // The move (0-based).
+    static constexpr int kNumPlayers{2};
+    static constexpr int kWinsToWin{3};
+
+    State Initial(std::mt19937&) const { return {{0, 0}, -1, 0, {}}; }
+
+    int CurrentPlayer(const State& state) const { return state.pending == -1 ? 0 : 1; }
+
+    void LegalActions(const State&, std::vector<Action>& actions) const {
+      actions.clear();
+      for (int move{0}; move < N; ++move) actions.push_back(move);
+    }
+
+    State Apply(State state, const Action& move) const {
+      if (state.pending == -1) {
+        state.pending = move;
+        return state;
+      }
+      const int result{Rules<N>::CheckWin(state.pending, move)};
+      if (result == 1) ++state.wins[0];
+      if (result == -1) ++state.wins[1];
+      state.recent[state.num_rounds++ % kRecentRounds] = {state.pending, move};
+      state.pending = -1;
+      return state;
+    }
+
+    bool IsTerminal(const State& state) const {
+      return state.wins[0] == kWinsToWin || state.wins[1] == kWinsToWin;
+    }
+
+    double Outcome(const State& state, const int player) const { return state.wins[player] == kWinsToWin ? 1 : 0; }
+
+    std::string Render(const State& state) const {
+      std::string text;
+      for (uint64_t round{state.FirstRecent()}; round < state.num_rounds; ++round)
+        text += Emojify(state.Round(round).first) + " " + Emojify(state.Round(round).second) + "\n";
+      return text + std::to_string(state.wins[0]) + " - " + std::to_string(state.wins[1]) + "\n";
+    }
+
+    std::string ActionName(const Action& move) const { return Emojify(move); }
+
+    bool ParseAction(const std::string& text, Action& move) const {
+      for (int m{0}; m < N; ++m) {
+        if (text == std::to_string(m + 1) || text == Emojify(m) || (m < kNumNamedMoves && text == kMoves[m].name)) {
+          move = m;
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  /**
+   * @brief Plays a match with one of the tournament bots, which learns from the finished rounds.
+   */
+  template <int N>
+  class BotAgent : public Engine::Agent<Game<N>> {
+   public:
+    explicit BotAgent(std::unique_ptr<Bot<N>> bot) : bot_(std::move(bot)) {}
+
+    int Act(const Game<N>& game, const typename Game<N>::State& state, std::mt19937&) override {
+      const int player{game.CurrentPlayer(state)};
+      // The bot plays every round, it never misses more than the kept ones
+      for (seen_ = std::max(seen_, state.FirstRecent()); seen_ < state.num_rounds; ++seen_) {
+        const auto& [first, second] = state.Round(seen_);
+        bot_->Observe(player == 0 ? first : second, player == 0 ? second : first);
+      }
+      return bot_->Choose();
+    }
+
+   private:
+    std::unique_ptr<Bot<N>> bot_;
+    uint64_t seen_{0}; // Rounds already observed.
+  };
+}
+
+#endif // JAJANKEN_ENGINE_H
@@ -0,0 +1,87 @@
+#ifndef JAJANKEN_GAME_H
+#define JAJANKEN_GAME_H
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../common/keyboard.h"
+#include "../common/stats_store.h"
+#include "bots.h"
+#include "rps_engine.h"
+#include "tournament.h"
+
+namespace Jajanken {
+  /**
+   * @brief Executes a round of the Jajanken game.
+   *
+   * @param ai The AI opponent, learns from the round.
+   * @return 1 if the user wins, -1 if the AI wins, 0 if it's a tie.
+   */
+  template <int N>
+  int GameRound(PredictorBot<N>& ai) {
+    std::cout << MovesPrompt(N);
+    std::string line;
+    if (!Keyboard::input.ReadLine(line)) std::exit(0);
+    char* end;
+    const long user_input{std::strtol(line.c_str(), &end, 10)};
+    if (line.empty() || *end != '\0') {
+      std::cerr << "Input error, not an integer!" << std::endl;
+      return 0;
+    } else if (user_input < 1 || user_input > N) {
+      std::cerr << "This number is not valid, must be between 1 and " << N;
+      return 0;
+    }
+    const int user_choice{static_cast<int>(user_input) - 1};
+    const int game_choice{ai.Choose()};
+    ai.Observe(game_choice, user_choice);
+    std::cout << std::endl << "You " << Emojify(user_choice) << "   " << Emojify(game_choice) << "  AI";
+    return Rules<N>::CheckWin(user_choice, game_choice);
+  }
+
+  /**
+   * @brief Runs the game against the user, or a bot tournament with
+   *        `--tournament [rounds]`.
+   *
+   * @param argc The number of arguments.
+   * @param argv The arguments given to the program.
+   * @return The exit status of the program.
+   */
+  template <int N>
+  int Play(const int argc, char* argv[]) {
+    for (int i{1}; i < argc; ++i) {
+      if (std::strcmp(argv[i], "--tournament") != 0) continue;
+      RunTournament<N>(i + 1 < argc ? std::strtoull(argv[i + 1], nullptr, 10) : 10000000);
+      return 0;
+    }
+    int wins{0}, loses{0}, ties{0}, status_round{0};
+    // The predictor tables make the bot too large for the stack
+    const auto ai = std::make_unique<PredictorBot<N>>(std::random_device{}());
+    const Stats::Game game{N == 3 ? Stats::Game::jajanken : Stats::Game::jajanken_tbbt};
+    std::cout << "Win 3 times to get the victory!" << std::endl;
+    while (true) {
+      status_round = GameRound(*ai);
+      if (status_round == 1) ++wins;
+      else if (status_round == -1) ++loses;
+      else ++ties;
+      std::cout << "\n     " << wins << " - " << loses << "\n\n";
+      if (wins >= 3) {
+        std::cout << "User wins!" << std::endl;
+        Stats::RecordResult(game, Stats::Outcome::win);
+        return 0;
+      } else if (loses >= 3) {
+        std::cout << "AI wins!" << std::endl;
+        Stats::RecordResult(game, Stats::Outcome::loss);
+        return 0;
+      } else if (ties >= 100) {
+        std::cout << "You have invoked a black hole, congratulations!" << std::endl;
+        Stats::RecordResult(game, Stats::Outcome::draw);
+        return 0;
+      }
+    }
+  }
+}
+
+#endif // JAJANKEN_GAME_H
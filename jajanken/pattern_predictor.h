@@ -0,0 +1,157 @@
+#ifndef PATTERN_PREDICTOR_H
+#define PATTERN_PREDICTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Online predictor of the next move of a player from their history.
+ *
+ * An ensemble of n-gram predictors: contexts of the last 0 to 4 moves of the
+ * player, and of the last 1 to 3 rounds (both moves). Each one counts what
+ * the player did after its context in a fixed-size hashed table, and the
+ * ensemble mixes them with weights that follow how well each one predicted
+ * lately (multiplicative weights). Every update is O(1) and the tables are
+ * part of the object, so its size is fixed however long the session runs.
+ *
+ * @tparam kMoves The number of moves of the game.
+ * @tparam kTableBits Every table has 2^kTableBits contexts; short matches
+ *         see few contexts and do well with small tables.
+ */
+template <int kMoves, int kTableBits = 12>
+class PatternPredictor {
+ public:
+  PatternPredictor() : entries_(), weights_() { weights_.fill(1.0 / kPredictors); }
+
+  /**
+   * @brief Predicts the next move of the player.
+   *
+   * @return The probability of every move (0-based).
+   */
+  std::array<double, kMoves> Predict() const {
+    std::array<double, kMoves> mixture{};
+    for (int predictor{0}; predictor < kPredictors; ++predictor) {
+      const std::array<double, kMoves> prediction{Distribution(predictor)};
+      for (int move{0}; move < kMoves; ++move) mixture[move] += weights_[predictor] * prediction[move];
+    }
+    return mixture;
+  }
+
+  /**
+   * @brief Learns from a finished round.
+   *
+   * @param player_move The move of the predicted player (0-based).
+   * @param opponent_move The move of the other player (0-based).
+   */
+  void Update(const int player_move, const int opponent_move) {
+    // Reward every predictor by the probability it gave to what happened
+    double total{0};
+    for (int predictor{0}; predictor < kPredictors; ++predictor) {
+      const double loss{1.0 - Distribution(predictor)[player_move]};
+      weights_[predictor] = std::max(weights_[predictor] * std::exp(-kLearningRate * loss), kMinWeight);
+      total += weights_[predictor];
+    }
+    for (double& weight : weights_) weight /= total;
+    for (int predictor{0}; predictor < kPredictors; ++predictor) {
+      if (!HasContext(predictor)) continue;
+      const uint64_t key{Key(predictor)};
+      Entry& entry = entries_[predictor * kTableSize + (key & (kTableSize - 1))];
+      // A different context hashed to the same slot, it takes the slot over
+      if (entry.tag != static_cast<uint32_t>(key >> 32)) entry = Entry{static_cast<uint32_t>(key >> 32), {}};
+      // Halving keeps the counts small and the recent habits weighing more
+      if (++entry.counts[player_move] == kMaxCount)
+        for (uint8_t& count : entry.counts) count /= 2;
+    }
+    for (int i{kMaxOrder - 1}; i > 0; --i) history_[i] = history_[i - 1];
+    history_[0] = player_move * kMoves + opponent_move;
+    ++rounds_;
+  }
+
+  /**
+   * @brief Chooses the move with the best expected result against the prediction.
+   *
+   * @param prediction The probability of every move of the player.
+   * @param player_score Returns 1 if the player wins, -1 if they lose and 0
+   *        on a tie, called as player_score(player_move, move) with 0-based moves.
+   * @param generator Breaks ties between equally good moves.
+   * @return The counter move (0-based).
+   */
+  template <typename Score>
+  static int CounterMove(const std::array<double, kMoves>& prediction, const Score& player_score,
+                         std::mt19937& generator) {
+    std::array<double, kMoves> value{};
+    double best{-2};
+    for (int move{0}; move < kMoves; ++move) {
+      for (int player_move{0}; player_move < kMoves; ++player_move)
+        value[move] -= prediction[player_move] * player_score(player_move, move);
+      best = std::max(best, value[move]);
+    }
+    std::vector<int> best_moves;
+    for (int move{0}; move < kMoves; ++move)
+      if (value[move] > best - 1e-9) best_moves.push_back(move);
+    std::uniform_int_distribution<size_t> pick(0, best_moves.size() - 1);
+    return best_moves[pick(generator)];
+  }
+
+ private:
+  // Predictors 0 to 4 look at the last moves of the player, 5 to 7 at the last rounds
+  static constexpr int kPlayerOrders{5};
+  static constexpr int kRoundOrders{3};
+  static constexpr int kPredictors{kPlayerOrders + kRoundOrders};
+  static constexpr int kMaxOrder{4};
+  static constexpr int kTableSize{1 << kTableBits};
+  static constexpr uint8_t kMaxCount{64};
+  static constexpr double kLearningRate{0.3};
+  static constexpr double kMinWeight{1e-4};
+
+  struct Entry {
+    uint32_t tag;                        // High bits of the context hash.
+    std::array<uint8_t, kMoves> counts;  // Moves seen after the context.
+  };
+
+  int Order(const int predictor) const {
+    return predictor < kPlayerOrders ? predictor : predictor - kPlayerOrders + 1;
+  }
+
+  bool HasContext(const int predictor) const { return rounds_ >= static_cast<uint64_t>(Order(predictor)); }
+
+  uint64_t Key(const int predictor) const {
+    uint64_t key{static_cast<uint64_t>(predictor) + 1};
+    for (int i{0}; i < Order(predictor); ++i) {
+      // The player only predictors drop the move of the opponent
+      const int symbol{predictor < kPlayerOrders ? history_[i] / kMoves : history_[i]};
+      key = (key ^ static_cast<uint64_t>(symbol + 1)) * 0x100000001b3ULL;
+    }
+    // Final mix so both the slot and the tag depend on every bit
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  std::array<double, kMoves> Distribution(const int predictor) const {
+    std::array<double, kMoves> distribution;
+    distribution.fill(1.0 / kMoves);
+    if (!HasContext(predictor)) return distribution;
+    const uint64_t key{Key(predictor)};
+    const Entry& entry = entries_[predictor * kTableSize + (key & (kTableSize - 1))];
+    if (entry.tag != static_cast<uint32_t>(key >> 32)) return distribution;
+    double total{0};
+    for (const uint8_t count : entry.counts) total += count;
+    if (total == 0) return distribution;
+    for (int move{0}; move < kMoves; ++move)
+      distribution[move] = (entry.counts[move] + 0.1) / (total + 0.1 * kMoves);
+    return distribution;
+  }
+
+  std::array<Entry, kPredictors * kTableSize> entries_; // One table of kTableSize entries per predictor.
+  std::array<double, kPredictors> weights_;             // Weight of every predictor in the mixture.
+  std::array<int, kMaxOrder> history_{};                // Last rounds, newest first, as player * kMoves + opponent.
+  uint64_t rounds_{0};
+};
+
+#endif // PATTERN_PREDICTOR_H
@@ -0,0 +1,90 @@
+#ifndef RPS_ENGINE_H
+#define RPS_ENGINE_H
+
+#include <array>
+#include <random>
+#include <string>
+
+namespace Jajanken {
+  // Initialize the random generator once per thread
+  inline thread_local std::mt19937 generator(std::random_device{}());
+
+  /**
+   * @brief A named move of the game.
+   */
+  struct Move {
+    const char* name;
+    const char* emoji;
+  };
+
+  // The moves in cyclic order: every move beats the moves an odd distance
+  // behind it, which for 3 and 5 moves gives the classic and the TBBT rules.
+  constexpr Move kMoves[]{{"rock", "🪨"}, {"paper", "📃"}, {"scissors", "✂️"}, {"spock", "🖖"}, {"lizard", "🦎"}};
+  constexpr int kNumNamedMoves{sizeof(kMoves) / sizeof(kMoves[0])};
+
+  /**
+   * @brief The rules of rock-paper-scissors with N moves.
+   *
+   * @tparam N The number of moves, any odd number so every move beats and
+   *         loses against the same number of moves.
+   */
+  template <int N>
+  struct Rules {
+    static_assert(N >= 3 && N % 2 == 1, "Jajanken needs an odd number of moves");
+
+    static constexpr int kNumMoves{N};
+
+    /**
+     * @brief Builds the outcome of every pair of moves at compile time.
+     */
+    static constexpr std::array<std::array<int, N>, N> MakeOutcomes() {
+      std::array<std::array<int, N>, N> outcomes{};
+      for (int a{0}; a < N; ++a)
+        for (int b{0}; b < N; ++b) {
+          const int distance{((a - b) % N + N) % N};
+          outcomes[a][b] = distance == 0 ? 0 : distance % 2 == 1 ? 1 : -1;
+        }
+      return outcomes;
+    }
+
+    static constexpr std::array<std::array<int, N>, N> kOutcomes{MakeOutcomes()};
+
+    /**
+     * @brief Checks the result of a round.
+     *
+     * @param user_choice The user's move (0-based).
+     * @param game_choice The AI's move (0-based).
+     * @return 1 if the user wins, -1 if the AI wins, 0 if it's a tie.
+     */
+    static constexpr int CheckWin(const int user_choice, const int game_choice) {
+      return kOutcomes[user_choice][game_choice];
+    }
+  };
+
+  /**
+   * @brief Converts a move to its emoji, moves past the named ones show their number.
+   *
+   * @param move The move (0-based).
+   * @return The emoji representation of the move.
+   */
+  inline std::string Emojify(const int move) {
+    if (move < kNumNamedMoves) return kMoves[move].emoji;
+    return "#" + std::to_string(move + 1);
+  }
+
+  /**
+   * @brief Builds the prompt listing every move, e.g. "🪨 (1), 📃 (2) or ✂️ (3): ".
+   *
+   * @param num_moves The number of moves of the game.
+   */
+  inline std::string MovesPrompt(const int num_moves) {
+    std::string prompt;
+    for (int move{0}; move < num_moves; ++move) {
+      if (move > 0) prompt += move == num_moves - 1 ? " or " : ", ";
+      prompt += Emojify(move) + " (" + std::to_string(move + 1) + ")";
+    }
+    return prompt + ": ";
+  }
+}
+
+#endif // RPS_ENGINE_H
@@ -0,0 +1,133 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "bots.h"
+#include "../common/parallel.h"
+
+namespace Jajanken {
+  // Rounds of one match, a fresh pair of bots plays every match
+  const int kRoundsPerMatch{1000};
+
+  /**
+   * @brief Wins, loses and ties of the first bot of every pair, mergeable between threads.
+   */
+  struct TournamentResults {
+    std::vector<uint64_t> wins, loses, ties; // Indexed by pair.
+
+    void Merge(const TournamentResults& other) {
+      if (wins.empty()) *this = TournamentResults{std::vector<uint64_t>(other.wins.size(), 0),
+                                                  std::vector<uint64_t>(other.wins.size(), 0),
+                                                  std::vector<uint64_t>(other.wins.size(), 0)};
+      for (size_t pair{0}; pair < other.wins.size(); ++pair) {
+        wins[pair] += other.wins[pair];
+        loses[pair] += other.loses[pair];
+        ties[pair] += other.ties[pair];
+      }
+    }
+  };
+
+  /**
+   * @brief Fits Elo ratings to the results of every pair (Bradley-Terry).
+   *
+   * @param num_bots The number of bots.
+   * @param score The score of bot i against bot j, a win counts 1 and a tie 0.5.
+   * @param games The number of rounds between bot i and bot j.
+   * @return The rating of every bot, with an average of 1500.
+   */
+  inline std::vector<double> FitElo(const int num_bots, const std::vector<std::vector<double>>& score,
+                                    const std::vector<std::vector<double>>& games) {
+    std::vector<double> ratings(num_bots, 1500);
+    for (int iteration{0}; iteration < 2000; ++iteration) {
+      for (int i{0}; i < num_bots; ++i) {
+        double actual{0}, expected{0}, total{0};
+        for (int j{0}; j < num_bots; ++j) {
+          if (i == j || games[i][j] == 0) continue;
+          // A prior of one tie keeps ratings finite when a bot never loses
+          actual += score[i][j] + 0.5;
+          expected += (games[i][j] + 1) / (1 + std::pow(10.0, (ratings[j] - ratings[i]) / 400));
+          total += games[i][j] + 1;
+        }
+        if (total > 0) ratings[i] += 400 * (actual - expected) / total;
+      }
+      double mean{0};
+      for (const double rating : ratings) mean += rating / num_bots;
+      for (double& rating : ratings) rating += 1500 - mean;
+    }
+    return ratings;
+  }
+
+  /**
+   * @brief Plays every pair of bots against each other on every core and
+   *        prints their ratings.
+   *
+   * @param total_rounds The number of rounds to play, split between every pair.
+   */
+  template <int N>
+  void RunTournament(const uint64_t total_rounds) {
+    const std::vector<BotFactory<N>> bots{AllBots<N>()};
+    const int num_bots{static_cast<int>(bots.size())};
+    std::vector<std::pair<int, int>> pairs;
+    for (int i{0}; i < num_bots; ++i)
+      for (int j{i + 1}; j < num_bots; ++j) pairs.emplace_back(i, j);
+    const uint64_t num_matches{std::max<uint64_t>(pairs.size(), total_rounds / kRoundsPerMatch)};
+    const auto start = std::chrono::steady_clock::now();
+    const TournamentResults results{Parallel::Accumulate<TournamentResults>(
+        num_matches, [&](TournamentResults& thread_results, uint64_t begin, uint64_t end, unsigned thread) {
+          thread_results.wins.assign(pairs.size(), 0);
+          thread_results.loses.assign(pairs.size(), 0);
+          thread_results.ties.assign(pairs.size(), 0);
+          std::mt19937_64 seeds(std::random_device{}() + thread);
+          for (uint64_t match{begin}; match < end; ++match) {
+            const size_t pair{match % pairs.size()};
+            const auto first = bots[pairs[pair].first].make(seeds());
+            const auto second = bots[pairs[pair].second].make(seeds());
+            for (int round{0}; round < kRoundsPerMatch; ++round) {
+              const int a{first->Choose()}, b{second->Choose()};
+              const int result{Rules<N>::CheckWin(a, b)};
+              if (result == 1) ++thread_results.wins[pair];
+              else if (result == -1) ++thread_results.loses[pair];
+              else ++thread_results.ties[pair];
+              first->Observe(a, b);
+              second->Observe(b, a);
+            }
+          }
+        })};
+    const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+    std::vector<std::vector<double>> score(num_bots, std::vector<double>(num_bots, 0));
+    std::vector<std::vector<double>> games(num_bots, std::vector<double>(num_bots, 0));
+    std::vector<uint64_t> wins(num_bots, 0), loses(num_bots, 0), ties(num_bots, 0);
+    for (size_t pair{0}; pair < pairs.size(); ++pair) {
+      const auto [i, j] = pairs[pair];
+      const double played = results.wins[pair] + results.loses[pair] + results.ties[pair];
+      games[i][j] = games[j][i] = played;
+      score[i][j] = results.wins[pair] + 0.5 * results.ties[pair];
+      score[j][i] = results.loses[pair] + 0.5 * results.ties[pair];
+      wins[i] += results.wins[pair], loses[i] += results.loses[pair], ties[i] += results.ties[pair];
+      wins[j] += results.loses[pair], loses[j] += results.wins[pair], ties[j] += results.ties[pair];
+    }
+    const std::vector<double> ratings{FitElo(num_bots, score, games)};
+    std::vector<int> order(num_bots);
+    for (int i{0}; i < num_bots; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&ratings](int a, int b) { return ratings[a] > ratings[b]; });
+    const uint64_t rounds{num_matches * kRoundsPerMatch};
+    std::cout << "Jajanken with " << N << " moves: " << rounds << " rounds in " << std::fixed
+              << std::setprecision(2) << elapsed.count() << " s (" << std::setprecision(0)
+              << rounds / elapsed.count() << " rounds/s)\n\n";
+    std::cout << std::left << std::setw(12) << "Bot" << std::right << std::setw(8) << "Elo" << std::setw(14)
+              << "Wins" << std::setw(14) << "Loses" << std::setw(14) << "Ties" << "\n";
+    for (const int i : order)
+      std::cout << std::left << std::setw(12) << bots[i].name << std::right << std::setw(8) << ratings[i]
+                << std::setw(14) << wins[i] << std::setw(14) << loses[i] << std::setw(14) << ties[i] << "\n";
+    std::cout << std::flush;
+  }
+}
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,68 @@
+// Shows the best players of the games, from the stats every game records.
+//
+//   leaderboard [--game <name>] [--top n] [--player name] [--compact]
+//
+// Without --game every game gets a table. --player shows one player's totals
+// instead, --compact folds the log of results into one record per total.
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../common/stats_store.h"
+
+void PrintLeaderboard(Stats::Store& store, const Stats::Game game, const size_t top) {
+  const auto standings = store.Leaderboard(game, top);
+  if (standings.empty()) return;
+  std::cout << Stats::kGameNames[static_cast<int>(game)] << "\n";
+  std::cout << std::fixed << std::setprecision(1);
+  for (size_t i{0}; i < standings.size(); ++i) {
+    const Stats::Totals& totals{standings[i].totals};
+    std::cout << std::setw(4) << i + 1 << ". " << std::left << std::setw(16) << standings[i].player << std::right
+              << std::setw(8) << totals.wins << " W" << std::setw(8) << totals.losses << " L" << std::setw(8)
+              << totals.draws << " D" << std::setw(8) << 100.0 * totals.wins / totals.Games() << "%\n";
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  std::string game_name, player;
+  size_t top{10};
+  bool compact{false};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--game") == 0 && i + 1 < argc) game_name = argv[++i];
+    else if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc) top = std::strtoull(argv[++i], nullptr, 10);
+    else if (std::strcmp(argv[i], "--player") == 0 && i + 1 < argc) player = argv[++i];
+    else if (std::strcmp(argv[i], "--compact") == 0) compact = true;
+  }
+  Stats::Store store;
+  if (!store.IsOpen()) {
+    std::cerr << "Could not open the stats in " << Stats::DefaultPrefix() << std::endl;
+    return 1;
+  }
+  if (compact && !store.Compact()) {
+    std::cerr << "Could not compact the stats" << std::endl;
+    return 1;
+  }
+  bool found{game_name.empty()};
+  for (int g{0}; g < Stats::kNumGames; ++g) {
+    if (!game_name.empty() && game_name != Stats::kGameNames[g]) continue;
+    found = true;
+    const Stats::Game game{static_cast<Stats::Game>(g)};
+    if (player.empty()) {
+      PrintLeaderboard(store, game, top);
+      continue;
+    }
+    const Stats::Totals totals{store.Get(player, game)};
+    if (totals.Games())
+      std::cout << player << " in " << Stats::kGameNames[g] << ": " << totals.wins << " wins, " << totals.losses
+                << " losses, " << totals.draws << " draws" << std::endl;
+  }
+  if (!found) {
+    std::cerr << "Unknown game " << game_name << std::endl;
+    return 1;
+  }
+  return 0;
+}
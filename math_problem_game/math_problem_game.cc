@@ -9,122 +9,194 @@
 // En este caso, este una simulación del problema donde se puede demostrar la
 // solución óptima en forma de juego.
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <random>
+#include <string>
 #include <vector>
 #include <iostream>
+#include <thread>
 
-#include "system_clear_screen.h"
+#include "../common/keyboard.h"
+#include "../common/viewport.h"
+#include "turbo_board.h"
+#include "turbo_pathfinder.h"
+#include "turbo_verifier.h"
 
 std::mt19937 generator(std::random_device{}());
 
-int GetRandomInt(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
-}
-
-const int rows{10}, cols{rows - 1}, monsters{rows - 2};
-struct Status {
-  bool has_monster = false;
-  bool been_discovered = false;
-};
-
 struct Player {
   int row{0};
   int col{0};
   int tries{1};
 };
 
-typedef std::vector<std::vector<Status>> matrix;
+// The largest part of the board shown at once
+const int kViewRows{10}, kViewCols{15};
 
-void InitializeGrid(matrix& grid) {
-  for (int i{1}; i < rows - 1; ++i) {
-    int monster_column_position = GetRandomInt(0, cols - 1);
-    bool can_place_monster = true;
-    // Check if in the same column there are a monster already
-    // so k is equivalent of rows
-    for (int k{1}; k < rows - 1; ++k) {
-      if (grid[k][monster_column_position].has_monster == true) {
-        can_place_monster = false;
-        break;
+void PrintGrid(const Player player, const Board& board, Viewport::GridRenderer& renderer) {
+  const Viewport::Window window{Viewport::Around(player.row, player.col, board.rows, board.cols, kViewRows, kViewCols)};
+  std::string status{"Tries: " + std::to_string(player.tries)};
+  if (window.rows < board.rows || window.cols < board.cols) {
+    status += "   rows " + std::to_string(window.first_row + 1) + "-" + std::to_string(window.first_row + window.rows) +
+              " of " + std::to_string(board.rows) + ", columns " + std::to_string(window.first_col + 1) + "-" +
+              std::to_string(window.first_col + window.cols) + " of " + std::to_string(board.cols);
+  }
+  renderer.SetStatus(0, status);
+  for (int i{0}; i < window.rows; ++i) {
+    const int row{window.first_row + i};
+    for (int j{0}; j < window.cols; ++j) {
+      const int col{window.first_col + j};
+      if (board.HasMonster(row, col) && board.IsDiscovered(row)) {
+        renderer.SetCell(i, j, " 👹 ");
+      } else if (player.row == row && player.col == col) {
+        renderer.SetCell(i, j, " 🐌 ");
+      } else {
+        renderer.SetCell(i, j, "    ");
       }
     }
-    if (can_place_monster) {
-      grid[i][monster_column_position].has_monster = true;
-    } else {
-      monster_column_position = GetRandomInt(0, cols - 1);
-      --i;
-    }
   }
+  renderer.Present();
 }
 
-void PrintGrid(const Player player, const matrix& grid) {
-  std::cout << "Tries: " << player.tries << std::endl;
-  for (int i{0}; i < rows; ++i) {
-    // Print the top part of cell
-    for (int j{0}; j < cols; ++j) std::cout << "+----";
-    std::cout << "+\n";
-    // Print the content of the cell
-    for (int j{0}; j < cols; ++j) {
-      std::cout << "|";
-      if (grid[i][j].has_monster == true && grid[i][j].been_discovered == true) {
-        std::cout << " 👹 ";
-      } else if (player.row == i && player.col == j) {
-        std::cout << " 🐌 ";
-      } else {
-        std::cout << "    ";
-      }
-    }
-    std::cout << "|\n";
+/**
+ * @brief Waits for a key, arrows move at once as well as l, r, u and d.
+ *
+ * @param think Work to do while the player decides.
+ * @return The direction, 'h' for a hint or any other character.
+ */
+char UserInput(const std::function<void()>& think) {
+  std::cout << "Move using the arrows or (l, r, u, d), or h for a hint: " << std::flush;
+  Keyboard::Key key{Keyboard::input.Read(think)};
+  while (key.code == Keyboard::enter) key = Keyboard::input.Read(think);
+  switch (key.code) {
+    case Keyboard::left:
+      return 'l';
+    case Keyboard::right:
+      return 'r';
+    case Keyboard::up:
+      return 'u';
+    case Keyboard::down:
+      return 'd';
+    case Keyboard::character:
+      return key.ch;
+    case Keyboard::end_of_input:
+      std::exit(0);
+    default:
+      return '?';
   }
-  // Print the down part of the cell
-  for (int j{0}; j < cols; ++j) std::cout << "+----";
-  std::cout << "+\n";
 }
 
-void UserInput(Player& player) {
-  std::cout << "Move using (l, r, u, d): ";
-  char direction;
-  std::cin >> direction;
+void Move(Player& player, const Board& board, const char direction) {
   switch (direction) {
     case 'l':
       if (player.col > 0) --player.col;
       break;
     case 'r':
-      if (player.col < cols - 1) ++player.col;
+      if (player.col < board.cols - 1) ++player.col;
       break;
     case 'u':
       if (player.row > 0) --player.row;
       break;
     case 'd':
-      if (player.row < rows - 1) ++player.row;
+      if (player.row < board.rows - 1) ++player.row;
       break;
   }
 }
 
-void PlayerCollided(Player& player, matrix& grid) {
-  if (grid[player.row][player.col].has_monster == true) {
-    grid[player.row][player.col].been_discovered = true;
+bool PlayerCollided(Player& player, Board& board) {
+  if (board.HasMonster(player.row, player.col)) {
+    board.Discover(player.row);
     player.row = 0;
     player.col = 0;
     ++player.tries;
+    return true;
   }
+  return false;
+}
+
+/**
+ * @brief The move from a cell to an adjacent one, or '?' if there is no route.
+ */
+char Direction(const Route& route) {
+  if (route.path.size() < 2) return '?';
+  const Cell from{route.path[0]}, to{route.path[1]};
+  if (to.row > from.row) return 'd';
+  if (to.row < from.row) return 'u';
+  return to.col > from.col ? 'r' : 'l';
+}
+
+std::string Describe(const Route& route, const double micros) {
+  if (route.path.empty()) return "Hint: no known route";
+  std::string text{"Hint: " + std::string(1, Direction(route)) + " ("};
+  text += route.reaches_goal ? "safe path to the last row, " : "explore row " + std::to_string(route.path.back().row) + ", ";
+  text += std::to_string(route.path.size() - 1) + " moves, planned in " + std::to_string(static_cast<int>(micros)) + " us)";
+  return text;
 }
 
-void Game(Player& player, matrix& grid) {
-  InitializeGrid(grid);
-  while (player.row < rows - 1) {
-    Console::ClearScreen();
-    PrintGrid(player, grid);
-    UserInput(player);
-    PlayerCollided(player, grid);
+void Game(Player& player, Board& board, const bool autopilot) {
+  InitializeGrid(board, generator);
+  Pathfinder pathfinder(board);
+  Viewport::GridRenderer renderer(std::min(board.rows, kViewRows), std::min(board.cols, kViewCols), 2);
+  Route route;
+  double planning_micros{0};
+  bool planned{false};
+  // Plans from the current cell once, the time the player spends thinking is used for it
+  const auto plan = [&] {
+    if (planned) return;
+    const auto start = std::chrono::steady_clock::now();
+    route = pathfinder.FindRoute(board, {player.row, player.col});
+    const std::chrono::duration<double, std::micro> elapsed{std::chrono::steady_clock::now() - start};
+    planning_micros = elapsed.count();
+    planned = true;
+  };
+  bool show_hint{false};
+  while (player.row < board.rows - 1) {
+    if (autopilot || show_hint) plan();
+    renderer.SetStatus(1, autopilot || show_hint ? Describe(route, planning_micros) : "");
+    PrintGrid(player, board, renderer);
+    char direction;
+    if (autopilot) {
+      direction = Direction(route);
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } else {
+      direction = UserInput(plan);
+    }
+    show_hint = direction == 'h';
+    const Player before{player};
+    Move(player, board, direction);
+    if (!PlayerCollided(player, board)) pathfinder.Visit(player.row, player.col);
+    if (player.row != before.row || player.col != before.col) planned = false;
   }
-  Console::ClearScreen();
-  PrintGrid(player, grid);
+  renderer.SetStatus(1, "");
+  PrintGrid(player, board, renderer);
 }
 
-int main() {
-  matrix grid(rows, std::vector<Status>(rows, {false, false}));
+int main(int argc, char* argv[]) {
+  int rows{-1};
+  uint64_t num_layouts{0};
+  std::string strategy{"optimal"};
+  bool autopilot{false};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc) rows = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) strategy = argv[++i];
+    else if (std::strcmp(argv[i], "--autopilot") == 0) autopilot = true;
+    else if (std::strcmp(argv[i], "--verify") == 0)
+      num_layouts = i + 1 < argc && std::isdigit(argv[i + 1][0]) ? std::strtoull(argv[++i], nullptr, 10) : 100000;
+  }
+  // The verifier plays the real problem unless told otherwise
+  if (rows == -1) rows = num_layouts > 0 ? 2024 : 10;
+  if (rows < 3) {
+    std::cerr << "The board needs at least 3 rows" << std::endl;
+    return 1;
+  }
+  if (num_layouts > 0) return Verifier::Run(strategy, rows, num_layouts) ? 0 : 1;
+  Board board(rows);
   Player player;
-  Game(player, grid);
+  Game(player, board, autopilot);
   std::cout << "You won!" << std::endl;
-}
\ No newline at end of file
+}
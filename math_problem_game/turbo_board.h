@@ -0,0 +1,53 @@
+#ifndef TURBO_BOARD_H
+#define TURBO_BOARD_H
+
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The board of the Turbo problem.
+ *
+ * Every row but the first and the last has exactly one monster and no two
+ * share a column, so the board is stored as the column of the monster of
+ * every row: O(rows) memory instead of a rows x cols grid. A monster can only
+ * be discovered by running into it, so one bit per row is enough to know
+ * which ones Turbo remembers.
+ */
+struct Board {
+  int rows;
+  int cols;
+  std::vector<int> monster_col;     // Column of the monster of every row, -1 if it has none.
+  std::vector<uint64_t> discovered; // Bit r is set once the monster of row r was found.
+
+  explicit Board(const int num_rows)
+      : rows(num_rows), cols(num_rows - 1), monster_col(num_rows, -1), discovered((num_rows + 63) / 64, 0) {}
+
+  bool HasMonster(const int row, const int col) const { return monster_col[row] == col; }
+
+  bool IsDiscovered(const int row) const { return (discovered[row / 64] >> (row % 64)) & 1; }
+
+  void Discover(const int row) { discovered[row / 64] |= 1ULL << (row % 64); }
+};
+
+/**
+ * @brief Hides a monster in every row but the first and the last.
+ *
+ * The columns are dealt as a partial Fisher-Yates shuffle: O(rows), no retries.
+ *
+ * @param board The board, its monster columns are overwritten.
+ * @param generator The random generator to use.
+ */
+inline void InitializeGrid(Board& board, std::mt19937& generator) {
+  std::vector<int> columns(board.cols);
+  std::iota(columns.begin(), columns.end(), 0);
+  for (int i{1}; i < board.rows - 1; ++i) {
+    std::uniform_int_distribution<int> distribution(i - 1, board.cols - 1);
+    std::swap(columns[i - 1], columns[distribution(generator)]);
+    board.monster_col[i] = columns[i - 1];
+  }
+}
+
+#endif // TURBO_BOARD_H
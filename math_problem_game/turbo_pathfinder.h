@@ -0,0 +1,198 @@
+#ifndef TURBO_PATHFINDER_H
+#define TURBO_PATHFINDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "turbo_board.h"
+#include "turbo_strategy.h"
+
+/**
+ * @brief A planned route for Turbo.
+ */
+struct Route {
+  std::vector<Cell> path; // From the current cell (included) to the target.
+  bool reaches_goal;      // True if the whole path is known to be safe and ends in the last row,
+                          // false if it ends on the closest unexplored cell of the deepest row.
+};
+
+/**
+ * @brief Plans routes through the cells Turbo knows to be safe.
+ *
+ * A cell is known to be safe if it is in the first or the last row, if Turbo
+ * walked on it, if the monster of its row was found elsewhere, or if the
+ * monster of its column was found in another row. Rows are bitsets of 64
+ * columns per word, and the breadth-first search only touches the words of
+ * its frontier, so replanning on a 2024x2023 board takes microseconds.
+ */
+class Pathfinder {
+ public:
+  explicit Pathfinder(const Board& board)
+      : rows_(board.rows), cols_(board.cols), words_((board.cols + 63) / 64),
+        visited_(static_cast<size_t>(rows_) * words_, 0), known_cols_(words_, 0),
+        reached_(visited_.size(), 0), next_(visited_.size(), 0) {}
+
+  /**
+   * @brief Remembers a cell Turbo walked on safely.
+   */
+  void Visit(const int row, const int col) { visited_[Index(row, col / 64)] |= 1ULL << (col % 64); }
+
+  /**
+   * @brief Finds the shortest known-safe path to the last row, or else the
+   *        shortest one to an unexplored cell of the deepest reachable row.
+   *
+   * @param board The board, only its discovered monsters are looked at.
+   * @param from The cell where Turbo is.
+   * @return The route, with an empty path if Turbo is walled in.
+   */
+  Route FindRoute(const Board& board, const Cell from) {
+    std::fill(known_cols_.begin(), known_cols_.end(), 0);
+    for (int row{1}; row < rows_ - 1; ++row)
+      if (board.IsDiscovered(row)) known_cols_[board.monster_col[row] / 64] |= 1ULL << (board.monster_col[row] % 64);
+    // Only the words reached by the last search need clearing
+    for (const Entry& entry : levels_) reached_[Index(entry.row, entry.word)] = 0;
+    levels_.clear();
+    level_starts_.assign(1, 0);
+    levels_.push_back({from.row, from.col / 64, 1ULL << (from.col % 64)});
+    reached_[Index(from.row, from.col / 64)] = 1ULL << (from.col % 64);
+    Cell best_unknown{-1, -1}, best_parent{-1, -1};
+    int best_level{-1};
+    for (int level{0};; ++level) {
+      const size_t begin{level_starts_[level]}, end{levels_.size()};
+      if (begin == end) break;
+      level_starts_.push_back(end);
+      for (size_t e{begin}; e < end; ++e) {
+        const Entry entry{levels_[e]};
+        if (entry.row == rows_ - 1) {
+          ClearNext(end);
+          return {Backtrack(level, {entry.row, entry.word * 64 + LowestBit(entry.bits)}), true};
+        }
+        // Cells of the next level: left, right, up and down of the frontier
+        const uint64_t carry_left{entry.word > 0 ? entry.bits << 63 : 0};
+        const uint64_t carry_right{entry.word + 1 < words_ ? entry.bits >> 63 : 0};
+        Expand(board, entry.row, entry.word, (entry.bits << 1) | (entry.bits >> 1), level, entry, best_unknown, best_parent, best_level);
+        if (carry_left) Expand(board, entry.row, entry.word - 1, carry_left, level, entry, best_unknown, best_parent, best_level);
+        if (carry_right) Expand(board, entry.row, entry.word + 1, carry_right, level, entry, best_unknown, best_parent, best_level);
+        if (entry.row > 0) Expand(board, entry.row - 1, entry.word, entry.bits, level, entry, best_unknown, best_parent, best_level);
+        if (entry.row < rows_ - 1) Expand(board, entry.row + 1, entry.word, entry.bits, level, entry, best_unknown, best_parent, best_level);
+      }
+      ClearNext(end);
+    }
+    if (best_level == -1) return {{}, false};
+    std::vector<Cell> path{Backtrack(best_level, best_parent)};
+    path.push_back(best_unknown);
+    return {path, false};
+  }
+
+ private:
+  struct Entry {
+    int row;
+    int word;
+    uint64_t bits;
+  };
+
+  size_t Index(const int row, const int word) const { return static_cast<size_t>(row) * words_ + word; }
+
+  /**
+   * @brief Moves the words touched in `next_` since `begin` into their entries and clears them.
+   */
+  void ClearNext(const size_t begin) {
+    for (size_t e{begin}; e < levels_.size(); ++e) {
+      uint64_t& bits = next_[Index(levels_[e].row, levels_[e].word)];
+      levels_[e].bits = bits;
+      bits = 0;
+    }
+  }
+
+  static int LowestBit(const uint64_t bits) { return __builtin_ctzll(bits); }
+
+  uint64_t ValidMask(const int word) const {
+    const int bits_in_word{std::min(64, cols_ - word * 64)};
+    return bits_in_word == 64 ? ~0ULL : (1ULL << bits_in_word) - 1;
+  }
+
+  uint64_t MonsterMask(const Board& board, const int row, const int word) const {
+    if (!board.IsDiscovered(row) || board.monster_col[row] / 64 != word) return 0;
+    return 1ULL << (board.monster_col[row] % 64);
+  }
+
+  uint64_t SafeMask(const Board& board, const int row, const int word) const {
+    if (row == 0 || row == rows_ - 1) return ValidMask(word);
+    if (board.IsDiscovered(row)) return ValidMask(word) & ~MonsterMask(board, row, word);
+    return visited_[Index(row, word)] | known_cols_[word];
+  }
+
+  /**
+   * @brief Adds the safe candidate cells to the next level and keeps the best unknown one.
+   */
+  void Expand(const Board& board, const int row, const int word, const uint64_t candidates, const int level,
+              const Entry& from, Cell& best_unknown, Cell& best_parent, int& best_level) {
+    const uint64_t valid{candidates & ValidMask(word)};
+    const uint64_t safe{SafeMask(board, row, word)};
+    const uint64_t unknown{valid & ~safe & ~MonsterMask(board, row, word)};
+    if (unknown && row > best_unknown.row) {
+      // Any frontier cell next to the unknown one is a valid parent
+      const int col{word * 64 + LowestBit(unknown)};
+      best_unknown = {row, col};
+      best_parent = {from.row, Neighbour(from, row, col)};
+      best_level = level;
+    }
+    const size_t index{Index(row, word)};
+    const uint64_t fresh{valid & safe & ~reached_[index]};
+    if (!fresh) return;
+    reached_[index] |= fresh;
+    if (next_[index] == 0) levels_.push_back({row, word, 0});
+    next_[index] |= fresh;
+  }
+
+  /**
+   * @brief The column of a cell of the entry next to the cell (row, col).
+   */
+  int Neighbour(const Entry& from, const int row, const int col) const {
+    for (const int candidate : {col, col - 1, col + 1}) {
+      if (candidate < from.word * 64 || candidate >= from.word * 64 + 64) continue;
+      if (!((from.bits >> (candidate % 64)) & 1)) continue;
+      if (std::abs(from.row - row) + std::abs(candidate - col) == 1) return candidate;
+    }
+    return col;
+  }
+
+  /**
+   * @brief Rebuilds the path from the start to a cell of the given level.
+   */
+  std::vector<Cell> Backtrack(const int level, Cell cell) const {
+    std::vector<Cell> path(level + 1);
+    path[level] = cell;
+    for (int l{level - 1}; l >= 0; --l) {
+      bool found{false};
+      for (size_t e{level_starts_[l]}; e < level_starts_[l + 1] && !found; ++e) {
+        const Entry& entry = levels_[e];
+        for (const Cell next : {Cell{cell.row, cell.col - 1}, Cell{cell.row, cell.col + 1},
+                                Cell{cell.row - 1, cell.col}, Cell{cell.row + 1, cell.col}}) {
+          if (next.row != entry.row || next.col < 0 || next.col / 64 != entry.word) continue;
+          if ((entry.bits >> (next.col % 64)) & 1) {
+            cell = next;
+            found = true;
+            break;
+          }
+        }
+      }
+      path[l] = cell;
+    }
+    return path;
+  }
+
+  int rows_;
+  int cols_;
+  int words_;                       // 64-bit words per row.
+  std::vector<uint64_t> visited_;   // Cells Turbo walked on.
+  std::vector<uint64_t> known_cols_; // Columns whose monster was found.
+  std::vector<uint64_t> reached_;   // Cells already reached by the search.
+  std::vector<uint64_t> next_;      // Cells of the level being built.
+  std::vector<Entry> levels_;       // The non empty words of every level, in order.
+  std::vector<size_t> level_starts_; // Where every level starts in `levels_`.
+};
+
+#endif // TURBO_PATHFINDER_H
@@ -0,0 +1,162 @@
+#ifndef TURBO_STRATEGY_H
+#define TURBO_STRATEGY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A cell of the board.
+ */
+struct Cell {
+  int row;
+  int col;
+};
+
+/**
+ * @brief What Turbo knows before an attempt: the size of the board and the
+ *        monsters it ran into so far.
+ */
+struct Knowledge {
+  int rows;
+  int cols;
+  std::vector<int> monster_col; // Column of the monster of every row, -1 while unknown.
+  int attempts{0};              // Attempts already finished.
+
+  Knowledge(const int num_rows, const int num_cols)
+      : rows(num_rows), cols(num_cols), monster_col(num_rows, -1) {}
+};
+
+/**
+ * @brief A policy for Turbo: the path of every attempt given what it knows.
+ *
+ * A path starts in the first row and moves one cell up, down, left or right
+ * at a time. An attempt ends when it reaches the last row or runs into a
+ * monster, which then becomes known for the next attempts.
+ */
+class Strategy {
+ public:
+  virtual ~Strategy() = default;
+  virtual std::string Name() const = 0;
+  virtual std::vector<Cell> NextAttempt(const Knowledge& knowledge) = 0;
+};
+
+/**
+ * @brief The optimal strategy, which always reaches the last row in at most 3 attempts.
+ *
+ * 1. Walk the second row (row 1) from left to right, which finds its monster at c.
+ * 2. If c is not on an edge, go down column c - 1 to row 2, step right to
+ *    column c and go down column c, which is safe below row 1. If (2, c - 1)
+ *    has a monster, row 2 is safe elsewhere, so the 3rd attempt does the
+ *    same through column c + 1.
+ * 3. If c is on an edge, say column 0, climb down a staircase (r, r),
+ *    (r, r + 1), (r + 1, r + 1)... If it runs into a monster in row i, the
+ *    3rd attempt follows the staircase to row i, walks row i, safe but for
+ *    that monster, to column 0 and goes down column 0, safe below row 1.
+ */
+class OptimalStrategy : public Strategy {
+ public:
+  std::string Name() const override { return "optimal"; }
+
+  std::vector<Cell> NextAttempt(const Knowledge& knowledge) override {
+    std::vector<Cell> path;
+    const int c{knowledge.monster_col[1]};
+    if (c == -1) {
+      path.push_back({0, 0});
+      for (int j{0}; j < knowledge.cols; ++j) path.push_back({1, j});
+      return path;
+    }
+    if (c > 0 && c < knowledge.cols - 1) {
+      const bool left_blocked{knowledge.rows > 3 && knowledge.monster_col[2] == c - 1};
+      const int side{left_blocked ? c + 1 : c - 1};
+      WalkFirstRow(side, path);
+      path.push_back({1, side});
+      path.push_back({2, side});
+      for (int i{2}; i < knowledge.rows; ++i) path.push_back({i, c});
+      return path;
+    }
+    // On the right edge, play the left edge case on the mirrored board
+    const bool mirrored{c != 0};
+    int hit_row{-1};
+    for (int i{2}; i < knowledge.rows - 1; ++i)
+      if (knowledge.monster_col[i] != -1) hit_row = i;
+    if (hit_row == -1) {
+      Staircase(knowledge, knowledge.rows, path);
+    } else {
+      // Follow the staircase to the last safe cell before row hit_row
+      const int hit_col{mirrored ? knowledge.cols - 1 - knowledge.monster_col[hit_row] : knowledge.monster_col[hit_row]};
+      Staircase(knowledge, hit_row, path);
+      if (hit_col == hit_row) {
+        // Monster at (i, i): leave the staircase at (i - 1, i - 1)
+        path.pop_back();
+        path.push_back({hit_row, hit_row - 1});
+      } else {
+        // Monster at (i, i + 1): (i, i) is safe
+        path.push_back({hit_row, hit_row});
+      }
+      for (int j{path.back().col - 1}; j >= 0; --j) path.push_back({hit_row, j});
+      for (int i{hit_row + 1}; i < knowledge.rows; ++i) path.push_back({i, 0});
+    }
+    if (mirrored)
+      for (Cell& cell : path) cell.col = knowledge.cols - 1 - cell.col;
+    return path;
+  }
+
+ private:
+  static void WalkFirstRow(const int to_col, std::vector<Cell>& path) {
+    for (int j{0}; j <= to_col; ++j) path.push_back({0, j});
+  }
+
+  /**
+   * @brief The staircase (0, 0), (0, 1), (1, 1), (1, 2), (2, 2)... up to,
+   *        not including, the first cell of row `stop_row`.
+   */
+  static void Staircase(const Knowledge& knowledge, const int stop_row, std::vector<Cell>& path) {
+    path.push_back({0, 0});
+    path.push_back({0, 1});
+    for (int r{1}; r < stop_row; ++r) {
+      path.push_back({r, r});
+      if (r + 1 < knowledge.cols) path.push_back({r, r + 1});
+      else {
+        path.push_back({r + 1, r});
+        return;
+      }
+    }
+  }
+};
+
+/**
+ * @brief A naive strategy that tries every column straight down in turn,
+ *        an example of a policy that needs many attempts.
+ */
+class ColumnSweepStrategy : public Strategy {
+ public:
+  std::string Name() const override { return "column-sweep"; }
+
+  std::vector<Cell> NextAttempt(const Knowledge& knowledge) override {
+    // The first column not known to have a monster
+    std::vector<bool> blocked(knowledge.cols, false);
+    for (const int col : knowledge.monster_col)
+      if (col != -1) blocked[col] = true;
+    int col{0};
+    while (col < knowledge.cols - 1 && blocked[col]) ++col;
+    std::vector<Cell> path;
+    for (int j{0}; j <= col; ++j) path.push_back({0, j});
+    for (int i{1}; i < knowledge.rows; ++i) path.push_back({i, col});
+    return path;
+  }
+};
+
+/**
+ * @brief Builds a strategy by name.
+ *
+ * @param name The name of the strategy ("optimal" or "column-sweep").
+ * @return The strategy, or nullptr if the name is unknown.
+ */
+inline std::unique_ptr<Strategy> MakeStrategy(const std::string& name) {
+  if (name == "optimal") return std::make_unique<OptimalStrategy>();
+  if (name == "column-sweep") return std::make_unique<ColumnSweepStrategy>();
+  return nullptr;
+}
+
+#endif // TURBO_STRATEGY_H
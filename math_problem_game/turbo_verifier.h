@@ -0,0 +1,289 @@
+#ifndef TURBO_VERIFIER_H
+#define TURBO_VERIFIER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "turbo_board.h"
+#include "turbo_strategy.h"
+#include "../common/parallel.h"
+#include "../common/streaming_stats.h"
+
+namespace Verifier {
+  /**
+   * @brief Where the monsters are, fixed up front or decided while Turbo moves.
+   *
+   * The adaptive adversary may put a monster on any cell Turbo steps on that
+   * can still hold one: a row and a column without a monster yet. It does so
+   * with a given probability, 1 for the greedy adversary, so layouts differ
+   * even against a deterministic strategy. It keeps a witness, a free column
+   * for every row still without a monster that Turbo never crossed there, so
+   * a valid layout always remains: an action the witness doesn't allow is
+   * only taken if an augmenting path rematches the rows, otherwise the
+   * adversary takes the other one, which the witness allows.
+   */
+  class Layout {
+   public:
+    /**
+     * @param place_probability How often the adaptive adversary puts a monster
+     *        on a cell that can take one.
+     */
+    Layout(const Board& board, const bool adaptive, const double place_probability, std::mt19937& generator)
+        : board_(board), adaptive_(adaptive), place_probability_(place_probability), generator_(generator),
+          column_used_(board.cols, false) {
+      for (const int col : board_.monster_col)
+        if (col != -1) column_used_[col] = true;
+      if (!adaptive_) return;
+      witness_.assign(board_.rows, -1);
+      owner_.assign(board_.cols, -1);
+      std::vector<int> free_cols;
+      for (int col{0}; col < board_.cols; ++col)
+        if (!column_used_[col]) free_cols.push_back(col);
+      std::shuffle(free_cols.begin(), free_cols.end(), generator_);
+      for (int row{1}; row < board_.rows - 1; ++row) {
+        if (board_.monster_col[row] != -1) continue;
+        Match(row, free_cols.back());
+        free_cols.pop_back();
+      }
+    }
+
+    /**
+     * @brief Checks if there is a monster at a cell, placing one if the adversary wants it.
+     */
+    bool HasMonster(const int row, const int col) {
+      if (board_.HasMonster(row, col)) return true;
+      if (!adaptive_ || row == 0 || row == board_.rows - 1) return false;
+      if (board_.monster_col[row] != -1 || column_used_[col] || IsSafe(row, col)) return false;
+      const bool place{place_probability_ >= 1 || std::uniform_real_distribution<>()(generator_) < place_probability_};
+      if (witness_[row] == col) {
+        if (!place && Skip(row, col)) return false;
+        Place(row, col);
+        return true;
+      }
+      if (place && Place(row, col)) return true;
+      Skip(row, col);
+      return false;
+    }
+
+    /**
+     * @brief Gives the rows still without a monster their column of the witness.
+     */
+    const Board& Complete() {
+      for (int row{1}; row < board_.rows - 1; ++row)
+        if (board_.monster_col[row] == -1) board_.monster_col[row] = witness_[row];
+      return board_;
+    }
+
+   private:
+    void Match(const int row, const int col) {
+      witness_[row] = col;
+      owner_[col] = row;
+    }
+
+    bool IsSafe(const int row, const int col) const {
+      return safe_.count(static_cast<uint64_t>(row) * board_.cols + col) > 0;
+    }
+
+    /**
+     * @brief Puts a monster on a cell, unless the row that had its column in
+     *        the witness finds no other.
+     */
+    bool Place(const int row, const int col) {
+      const int old{witness_[row]}, other{owner_[col]};
+      board_.monster_col[row] = col;
+      column_used_[col] = true;
+      witness_[row] = -1;
+      owner_[old] = -1;
+      owner_[col] = -1;
+      // The column was the row's own or nobody's
+      if (other == row || other == -1) return true;
+      witness_[other] = -1;
+      // The column the row leaves is the first try
+      if (!IsSafe(other, old)) {
+        Match(other, old);
+        return true;
+      }
+      if (Augment(other)) return true;
+      board_.monster_col[row] = -1;
+      column_used_[col] = false;
+      Match(row, old);
+      Match(other, col);
+      return false;
+    }
+
+    /**
+     * @brief Leaves a cell without a monster for good, unless its row finds
+     *        no other column in the witness.
+     */
+    bool Skip(const int row, const int col) {
+      safe_.insert(static_cast<uint64_t>(row) * board_.cols + col);
+      if (witness_[row] != col) return true;
+      owner_[col] = -1;
+      witness_[row] = -1;
+      if (Augment(row)) return true;
+      safe_.erase(static_cast<uint64_t>(row) * board_.cols + col);
+      Match(row, col);
+      return false;
+    }
+
+    /**
+     * @brief Finds a column of the witness for a row, moving other rows along
+     *        an augmenting path if needed.
+     */
+    bool Augment(const int row) {
+      visited_.assign(board_.cols, false);
+      return Visit(row);
+    }
+
+    bool Visit(const int row) {
+      // A column nobody holds first, there is always one more column than rows
+      for (int col{0}; col < board_.cols; ++col) {
+        if (column_used_[col] || owner_[col] != -1 || visited_[col] || IsSafe(row, col)) continue;
+        Match(row, col);
+        return true;
+      }
+      for (int col{0}; col < board_.cols; ++col) {
+        if (column_used_[col] || visited_[col] || IsSafe(row, col)) continue;
+        visited_[col] = true;
+        if (owner_[col] == -1 || Visit(owner_[col])) {
+          Match(row, col);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    Board board_;
+    bool adaptive_;
+    double place_probability_;
+    std::mt19937& generator_;
+    std::vector<bool> column_used_;
+    std::vector<int> witness_;         // The column of every row without a monster.
+    std::vector<int> owner_;           // The row of every column in the witness, -1 for none.
+    std::unordered_set<uint64_t> safe_; // Cells Turbo crossed that never get a monster.
+    std::vector<bool> visited_;
+  };
+
+  /**
+   * @brief Lets a strategy play until it reaches the last row.
+   *
+   * @param strategy The strategy that chooses the paths.
+   * @param layout The monsters of the board.
+   * @param max_attempts Attempts after which the strategy is considered stuck.
+   * @return The number of attempts needed, or -1 if a path was not valid
+   *         (not adjacent moves, out of the board or not reaching the last row).
+   */
+  inline int Play(Strategy& strategy, Layout& layout, const int rows, const int cols, const int max_attempts) {
+    Knowledge knowledge(rows, cols);
+    while (knowledge.attempts < max_attempts) {
+      const std::vector<Cell> path{strategy.NextAttempt(knowledge)};
+      ++knowledge.attempts;
+      if (path.empty() || path.front().row != 0) return -1;
+      bool hit{false};
+      for (size_t i{0}; i < path.size() && !hit; ++i) {
+        const Cell cell{path[i]};
+        if (cell.row < 0 || cell.row >= rows || cell.col < 0 || cell.col >= cols) return -1;
+        if (i > 0 && std::abs(cell.row - path[i - 1].row) + std::abs(cell.col - path[i - 1].col) != 1) return -1;
+        if (layout.HasMonster(cell.row, cell.col)) {
+          knowledge.monster_col[cell.row] = cell.col;
+          hit = true;
+        } else if (cell.row == rows - 1) {
+          return knowledge.attempts;
+        }
+      }
+      if (!hit) return -1;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Attempts needed over many layouts, mergeable between threads.
+   */
+  struct Results {
+    uint64_t layouts{0};
+    uint64_t failures{0};        // Layouts where the strategy was not valid or got stuck.
+    int worst{0};
+    std::vector<int> worst_layout; // Monster columns of a layout needing `worst` attempts.
+    RunningStats attempts;
+
+    void Add(const int num_attempts, const Board& board) {
+      ++layouts;
+      if (num_attempts < 0) {
+        ++failures;
+        return;
+      }
+      attempts.Add(num_attempts);
+      if (num_attempts > worst) {
+        worst = num_attempts;
+        worst_layout = board.monster_col;
+      }
+    }
+
+    void Merge(const Results& other) {
+      layouts += other.layouts;
+      failures += other.failures;
+      attempts.Merge(other.attempts);
+      if (other.worst > worst) {
+        worst = other.worst;
+        worst_layout = other.worst_layout;
+      }
+    }
+  };
+
+  /**
+   * @brief Plays a strategy against many layouts on every core and prints the results.
+   *
+   * @param strategy_name The name of the strategy, see MakeStrategy().
+   * @param rows The number of rows of the board.
+   * @param num_layouts The number of layouts of each kind, random and adversarial.
+   * @return True if the strategy always reached the last row, false otherwise.
+   */
+  inline bool Run(const std::string& strategy_name, const int rows, const uint64_t num_layouts) {
+    if (!MakeStrategy(strategy_name)) {
+      std::cerr << "Unknown strategy " << strategy_name << std::endl;
+      return false;
+    }
+    bool passed{true};
+    for (const bool adaptive : {false, true}) {
+      const auto start = std::chrono::steady_clock::now();
+      const Results results{Parallel::Accumulate<Results>(
+          num_layouts, [&](Results& thread_results, uint64_t begin, uint64_t end, unsigned) {
+            std::mt19937 generator(std::random_device{}());
+            const auto strategy = MakeStrategy(strategy_name);
+            const Board empty(rows);
+            for (uint64_t i{begin}; i < end; ++i) {
+              Board board(rows);
+              if (!adaptive) InitializeGrid(board, generator);
+              // The first adversary is the greedy one, the others leave a random share of the cells empty
+              const double place_probability{i == 0 ? 1 : std::uniform_real_distribution<>()(generator)};
+              Layout layout(adaptive ? empty : board, adaptive, place_probability, generator);
+              const int num_attempts{Play(*strategy, layout, rows, rows - 1, rows)};
+              thread_results.Add(num_attempts, layout.Complete());
+            }
+          })};
+      const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+      std::cout << (adaptive ? "Adversarial" : "Random") << " layouts, " << rows << "x" << rows - 1
+                << ", strategy " << strategy_name << ": " << results.layouts << " in " << elapsed.count()
+                << " s (" << static_cast<uint64_t>(results.layouts / elapsed.count()) << " layouts/s)\n"
+                << "  attempts: worst " << results.worst << ", average " << results.attempts.Mean()
+                << ", failures " << results.failures << "\n";
+      if (rows <= 12 && !results.worst_layout.empty()) {
+        std::cout << "  worst layout (monster column per row):";
+        for (const int col : results.worst_layout) std::cout << " " << col;
+        std::cout << "\n";
+      }
+      passed &= results.failures == 0;
+    }
+    std::cout << std::flush;
+    return passed;
+  }
+}
+
+#endif // TURBO_VERIFIER_H
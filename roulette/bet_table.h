@@ -0,0 +1,185 @@
+#ifndef BET_TABLE_H
+#define BET_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Roulette {
+  // European wheel, numbers from 0 to 36
+  const int kNumbers{37};
+
+  // Order of the numbers around the wheel, starting at 0
+  const int kWheelOrder[kNumbers]{0, 32, 15, 19, 4, 21, 2, 25, 17, 34, 6, 27, 13, 36, 11, 30, 8, 23, 10,
+                                  5, 24, 16, 33, 1, 20, 14, 31, 9, 22, 18, 29, 7, 28, 12, 35, 3, 26};
+
+  /**
+   * @brief Checks if a number is red on the European layout.
+   *
+   * @param number The number of the wheel (0 - 36).
+   * @return True if the number is red, false if it is black or 0.
+   */
+  inline bool IsRed(const int number) {
+    const uint64_t red_mask{(1ULL << 1) | (1ULL << 3) | (1ULL << 5) | (1ULL << 7) | (1ULL << 9) |
+                            (1ULL << 12) | (1ULL << 14) | (1ULL << 16) | (1ULL << 18) | (1ULL << 19) |
+                            (1ULL << 21) | (1ULL << 23) | (1ULL << 25) | (1ULL << 27) | (1ULL << 30) |
+                            (1ULL << 32) | (1ULL << 34) | (1ULL << 36)};
+    return (red_mask >> number) & 1;
+  }
+
+  /**
+   * @brief A kind of bet of the layout: the numbers it covers and what it pays.
+   */
+  struct BetType {
+    std::string name; // Name used to place the bet, e.g. "split 17 20".
+    uint64_t mask;    // Bit n is set if the bet covers the number n.
+    int payout;       // Payout multiplier, a winning bet returns stake * (payout + 1).
+  };
+
+  /**
+   * @brief Builds every bet of the European layout once.
+   *
+   * @return The catalog of straight-ups, splits, streets, corners, six-lines,
+   *         dozens, columns and even-money bets.
+   */
+  inline const std::vector<BetType>& Catalog() {
+    static const std::vector<BetType> catalog = [] {
+      std::vector<BetType> bets;
+      auto add = [&bets](const std::string& name, const int payout, auto covers) {
+        uint64_t mask{0};
+        for (int n{0}; n < kNumbers; ++n)
+          if (covers(n)) mask |= 1ULL << n;
+        bets.push_back({name, mask, payout});
+      };
+      for (int n{0}; n < kNumbers; ++n)
+        add("straight " + std::to_string(n), 35, [n](int x) { return x == n; });
+      for (int n{1}; n <= 3; ++n)
+        add("split 0 " + std::to_string(n), 17, [n](int x) { return x == 0 || x == n; });
+      for (int n{1}; n <= 36; ++n) {
+        // Horizontal neighbour on the same street and vertical neighbour on the next one
+        if (n % 3 != 0)
+          add("split " + std::to_string(n) + " " + std::to_string(n + 1), 17,
+              [n](int x) { return x == n || x == n + 1; });
+        if (n + 3 <= 36)
+          add("split " + std::to_string(n) + " " + std::to_string(n + 3), 17,
+              [n](int x) { return x == n || x == n + 3; });
+      }
+      for (int n{1}; n <= 34; n += 3)
+        add("street " + std::to_string(n), 11, [n](int x) { return x >= n && x < n + 3; });
+      for (int n{1}; n <= 32; ++n)
+        if (n % 3 != 0)
+          add("corner " + std::to_string(n), 8,
+              [n](int x) { return x == n || x == n + 1 || x == n + 3 || x == n + 4; });
+      for (int n{1}; n <= 31; n += 3)
+        add("sixline " + std::to_string(n), 5, [n](int x) { return x >= n && x < n + 6; });
+      for (int d{1}; d <= 3; ++d)
+        add("dozen " + std::to_string(d), 2, [d](int x) { return x > 12 * (d - 1) && x <= 12 * d; });
+      for (int c{1}; c <= 3; ++c)
+        add("column " + std::to_string(c), 2, [c](int x) { return x != 0 && x % 3 == c % 3; });
+      add("red", 1, [](int x) { return IsRed(x); });
+      add("black", 1, [](int x) { return x != 0 && !IsRed(x); });
+      add("odd", 1, [](int x) { return x % 2 == 1; });
+      add("even", 1, [](int x) { return x != 0 && x % 2 == 0; });
+      add("low", 1, [](int x) { return x >= 1 && x <= 18; });
+      add("high", 1, [](int x) { return x >= 19; });
+      return bets;
+    }();
+    return catalog;
+  }
+
+  /**
+   * @brief Looks up a bet of the catalog by name.
+   *
+   * The numbers of the name can be given in any order, so "split 20 17" is
+   * the same bet as "split 17 20".
+   *
+   * @param name The name of the bet.
+   * @return The index of the bet in the catalog, or -1 if the bet does not exist.
+   */
+  inline int FindBet(const std::string& name) {
+    static const std::unordered_map<std::string, int> index = [] {
+      std::unordered_map<std::string, int> by_name;
+      const auto& catalog = Catalog();
+      for (size_t i{0}; i < catalog.size(); ++i) by_name[catalog[i].name] = static_cast<int>(i);
+      return by_name;
+    }();
+    std::istringstream name_stream(name);
+    std::string kind, normalized;
+    name_stream >> kind;
+    std::vector<int> numbers;
+    for (int n; name_stream >> n;) numbers.push_back(n);
+    if (!name_stream.eof()) return -1;
+    std::sort(numbers.begin(), numbers.end());
+    normalized = kind;
+    for (const int n : numbers) normalized += " " + std::to_string(n);
+    const auto it = index.find(normalized);
+    return it == index.end() ? -1 : it->second;
+  }
+
+  /**
+   * @brief The open bets of every player at the table for the next spin.
+   *
+   * Bets are stored as parallel arrays so that settling a spin is a single
+   * mask test per bet in a branch-free loop the compiler can vectorize.
+   */
+  class BetTable {
+   public:
+    /**
+     * @brief Opens a bet for the next spin.
+     *
+     * @param player The index of the player placing the bet.
+     * @param bet The index of the bet in the catalog.
+     * @param stake The amount wagered.
+     */
+    void Place(const int player, const int bet, const int64_t stake) {
+      const BetType& type = Catalog()[bet];
+      masks_.push_back(type.mask);
+      multipliers_.push_back(type.payout + 1);
+      stakes_.push_back(stake);
+      players_.push_back(player);
+    }
+
+    /**
+     * @brief Pays every open bet for the winning number and closes them.
+     *
+     * @param number The number the ball fell in.
+     * @param returns Accumulates what each player gets back, indexed by player.
+     */
+    void Settle(const int number, std::vector<int64_t>& returns) {
+      const size_t num_bets{masks_.size()};
+      payouts_.resize(num_bets);
+      const uint64_t* masks{masks_.data()};
+      const int64_t* stakes{stakes_.data()};
+      const int32_t* multipliers{multipliers_.data()};
+      int64_t* payouts{payouts_.data()};
+      for (size_t i{0}; i < num_bets; ++i)
+        payouts[i] = static_cast<int64_t>((masks[i] >> number) & 1) * stakes[i] * multipliers[i];
+      for (size_t i{0}; i < num_bets; ++i) returns[players_[i]] += payouts[i];
+      Clear();
+    }
+
+    /**
+     * @brief Removes every open bet without paying it.
+     */
+    void Clear() {
+      masks_.clear();
+      multipliers_.clear();
+      stakes_.clear();
+      players_.clear();
+    }
+
+    size_t size() const { return masks_.size(); }
+
+   private:
+    std::vector<uint64_t> masks_;
+    std::vector<int32_t> multipliers_;
+    std::vector<int64_t> stakes_;
+    std::vector<int32_t> players_;
+    std::vector<int64_t> payouts_;
+  };
+}
+
+#endif // BET_TABLE_H
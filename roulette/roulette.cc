@@ -1,85 +1,191 @@
+#include <algorithm>
 #include <random>
 #include <chrono>
-#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
+
+#include "bet_table.h"
+#include "strategy_simulator.h"
+#include "../common/animation.h"
+#include "../common/fairness.h"
+#include "../common/keyboard.h"
+
+// Initialize the random generator once per thread
+thread_local std::mt19937 generator(std::random_device{}());
 
 /**
- * @brief Structure representing a string that is printed slowly with a delay between each character.
+ * @brief Generate a random integer between min and max (inclusive).
+ *
+ * @param min The minimum value of the random number.
+ * @param max The maximum value of the random number.
+ * @return A random integer between min and max.
  */
-struct SlowlyPrintingString {
-  std::string data; // The string to be printed slowly.
-  long int delay;   // The delay (in milliseconds) between each character.
-};
+int GetRandom(const int min, const int max) {
+  std::uniform_int_distribution<int> distribution(min, max);
+  return distribution(generator);
+}
 
 /**
- * @brief Overload the << operator to print SlowlyPrintingString objects character by character with a delay.
+ * @brief Asks a player for bets until they write "done" or run out of money.
  *
- * @param os The output stream to print to.
- * @param str The SlowlyPrintingString object to be printed.
- * @return The output stream after printing the SlowlyPrintingString object.
+ * @param player The index of the player.
+ * @param balances The money of every player, the stakes are taken from here.
+ * @param table The table where the bets are placed.
  */
-std::ostream& operator<<(std::ostream& os, const SlowlyPrintingString& str) {
-  for (const auto& c : str.data) {
-    os << c << std::flush;        
-    std::this_thread::sleep_for(std::chrono::milliseconds(str.delay));
+void PlaceBets(const int player, std::vector<int64_t>& balances, Roulette::BetTable& table) {
+  std::string line;
+  while (balances[player] > 0) {
+    std::cout << "Player " << player + 1 << " (" << balances[player] << "), bet or done: ";
+    if (!Keyboard::input.ReadLine(line) || line == "done") return;
+    // The stake is the last word of the line, the rest names the bet
+    const size_t last_space{line.find_last_of(' ')};
+    const int bet{last_space == std::string::npos ? -1 : Roulette::FindBet(line.substr(0, last_space))};
+    int64_t stake{0};
+    if (bet != -1) stake = std::atoll(line.c_str() + last_space + 1);
+    if (bet == -1 || stake <= 0) {
+      std::cout << "Not a valid bet, e.g. \"straight 17 5\", \"split 17 20 5\", \"street 16 5\",\n"
+                << "\"corner 16 5\", \"sixline 16 5\", \"dozen 2 5\", \"column 3 5\", \"red 5\",\n"
+                << "\"black 5\", \"odd 5\", \"even 5\", \"low 5\" or \"high 5\"" << std::endl;
+    } else if (stake > balances[player]) {
+      std::cout << "You don't have that much money!" << std::endl;
+    } else {
+      balances[player] -= stake;
+      table.Place(player, bet, stake);
+    }
   }
-  return os;
 }
 
-// Initialize the random generator once
-std::mt19937 generator(std::random_device{}());
+/**
+ * @brief Draws the pocket of the wheel where the ball falls.
+ *
+ * @return The position of the pocket in the wheel order.
+ */
+int DrawSlot() {
+  return GetRandom(0, Roulette::kNumbers - 1);
+}
 
 /**
- * @brief Generate a random integer between min and max (inclusive).
+ * @brief Spins the wheel and shows the ball running around it.
  *
- * @param min The minimum value of the random number.
- * @param max The maximum value of the random number.
- * @return A random integer between min and max.
+ * @return The number the ball fell in.
  */
-int GetRandom(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
+int SpinWheel() {
+  const int slot{DrawSlot()}, num_frames{30};
+  Animation::Scheduler scheduler(std::chrono::milliseconds(80));
+  // The ball slows down quadratically until it stops on the drawn slot
+  scheduler.Run(num_frames, [slot](const int frame, std::string& buffer) {
+    const int remaining{num_frames - 1 - frame};
+    const int number{Roulette::kWheelOrder[(slot + remaining * remaining / 2) % Roulette::kNumbers]};
+    buffer += "The ball falls in ... " + std::to_string(number);
+    buffer += number == 0 ? " green" : Roulette::IsRed(number) ? " red" : " black";
+  });
+  std::cout << std::endl;
+  return Roulette::kWheelOrder[slot];
 }
 
 /**
  * @brief Executes a single round of the game.
- *        This function prompts the user to choose a number between 0 and 32, 
- *        and then generates a random number.
- * 
- * @return true if the user's chosen number matches the generated random number, false otherwise.
+ *        Every player with money left places their bets, then the wheel is
+ *        spun and all the bets of the table are settled at once.
+ *
+ * @param balances The money of every player.
+ * @param table The table holding the bets of the round.
  */
-int GameRound() {
-  std::cout << "\nChoose a number (0 - 32): ";
-  int num{-1};
-  std::cin >> num;
-  if (std::cin.fail() || num < 0 || num > 32) {
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    return -1;
+void GameRound(std::vector<int64_t>& balances, Roulette::BetTable& table) {
+  for (int player{0}; player < static_cast<int>(balances.size()); ++player)
+    PlaceBets(player, balances, table);
+  if (table.size() == 0) return;
+  const int number{SpinWheel()};
+  std::vector<int64_t> returns(balances.size(), 0);
+  table.Settle(number, returns);
+  for (size_t player{0}; player < balances.size(); ++player) {
+    balances[player] += returns[player];
+    std::cout << "Player " << player + 1 << " wins " << returns[player]
+              << ", now has " << balances[player] << std::endl;
   }
-  int random_number = GetRandom(0, 32);
-  std::cout << "The ball falls in" << SlowlyPrintingString{" ... ", 500};
-  std::cout << random_number << " \t\t";
-  return num == random_number;
 }
 
-int main() {
-  const bool win{true};
-  std::cout << "Let's gamble!" << std::endl;
-  char option;
-  while (true) {
-    if (GameRound() == win) {
-      std::cout << "\nYou are a winner!" << std::endl;
-    } else if (!win) {
-      std::cout << "Aw, dang it!" << std::endl;
-    } else {
-      std::cout << "Choose a valid number!" << std::endl;
+/**
+ * @brief Batch mode: plays millions of sessions of a betting strategy and
+ *        prints the statistics of their bankrolls.
+ *
+ * @param argc The number of arguments.
+ * @param argv The arguments, `--simulate <strategy>` followed by options.
+ * @return The exit status of the program.
+ */
+int SimulateStrategy(const int argc, char* argv[]) {
+  Roulette::SessionConfig config;
+  uint64_t num_sessions{1000000};
+  std::string bet_name{"red"};
+  for (int i{1}; i + 1 < argc; ++i) {
+    const std::string option{argv[i]}, value{argv[i + 1]};
+    if (option == "--simulate" && !Roulette::ParseStrategy(value, config.strategy)) {
+      std::cerr << "Unknown strategy, use flat, martingale or dalembert" << std::endl;
+      return 1;
     }
+    if (option == "--sessions") num_sessions = std::strtoull(value.c_str(), nullptr, 10);
+    else if (option == "--bankroll") config.bankroll = std::atoll(value.c_str());
+    else if (option == "--stake") config.base_stake = std::atoll(value.c_str());
+    else if (option == "--target") config.target = std::atoll(value.c_str());
+    else if (option == "--max-spins") config.max_spins = std::atoll(value.c_str());
+    else if (option == "--bet") bet_name = value;
+  }
+  config.bet = Roulette::FindBet(bet_name);
+  if (config.bet == -1 || config.base_stake <= 0) {
+    std::cerr << "Not a valid bet or stake" << std::endl;
+    return 1;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  const Roulette::SimulationStats stats{
+      Roulette::Simulate(config, num_sessions, [] { return Roulette::kWheelOrder[DrawSlot()]; })};
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  const double sessions{static_cast<double>(stats.sessions)};
+  std::cout << std::fixed << std::setprecision(4)
+            << "Sessions:          " << stats.sessions << " (" << std::setprecision(0)
+            << sessions / elapsed.count() << " sessions/s)\n" << std::setprecision(4)
+            << "Ruin probability:  " << stats.ruined / sessions << "\n"
+            << "Reached target:    " << stats.reached_target / sessions << "\n"
+            << "Session length:    mean " << stats.length.Mean() << ", sd " << stats.length.StdDev()
+            << ", p50 " << stats.length_quantiles.Quantile(0.5) << ", p99 "
+            << stats.length_quantiles.Quantile(0.99) << "\n"
+            << "Final bankroll:    mean " << stats.final_bankroll.Mean() << ", sd "
+            << stats.final_bankroll.StdDev() << "\n";
+  for (const double q : {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99})
+    std::cout << "  p" << std::setprecision(0) << q * 100 << ": " << std::setprecision(2)
+              << stats.bankroll_quantiles.Quantile(q) << "\n";
+  std::cout << std::flush;
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  for (int i{1}; i < argc; ++i)
+    if (std::strcmp(argv[i], "--simulate") == 0) return SimulateStrategy(argc, argv);
+  // Every number of the wheel must come out with the same probability
+  if (const uint64_t num_draws{Fairness::ParseFlag(argc, argv)}) {
+    const std::vector<double> probabilities(Roulette::kNumbers, 1.0 / Roulette::kNumbers);
+    return Fairness::Run("roulette spin", num_draws, probabilities,
+                         [] { return Roulette::kWheelOrder[DrawSlot()]; }) ? 0 : 1;
+  }
+  Animation::ParseFlags(argc, argv);
+  std::cout << "Let's gamble!\nHow many players? ";
+  // Every prompt goes through the shared reader, the keys typed during a spin are not lost
+  std::string line;
+  const int num_players{Keyboard::input.ReadLine(line) ? std::atoi(line.c_str()) : 0};
+  if (num_players < 1 || num_players > 8) {
+    std::cerr << "Choose between 1 and 8 players!" << std::endl;
+    return 1;
+  }
+  std::vector<int64_t> balances(num_players, 100);
+  Roulette::BetTable table;
+  std::string option;
+  while (std::any_of(balances.begin(), balances.end(), [](int64_t money) { return money > 0; })) {
+    GameRound(balances, table);
     std::cout << "Do you want to play again? [any letter/n]: ";
-    std::cin >> option;
-    if (tolower(option) == 'n') break;
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (!Keyboard::input.ReadLine(option) || (!option.empty() && tolower(option[0]) == 'n')) return 0;
   }
+  std::cout << "Aw, dang it! The house always wins." << std::endl;
 }
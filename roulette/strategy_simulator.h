@@ -0,0 +1,132 @@
+#ifndef STRATEGY_SIMULATOR_H
+#define STRATEGY_SIMULATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "bet_table.h"
+#include "../common/parallel.h"
+#include "../common/streaming_stats.h"
+
+namespace Roulette {
+  /**
+   * @brief Enumerates the betting strategies the simulator knows.
+   */
+  enum Strategy { flat, martingale, dalembert };
+
+  /**
+   * @brief Parses the name of a strategy.
+   *
+   * @param name The name of the strategy ("flat", "martingale" or "dalembert").
+   * @param strategy The parsed strategy.
+   * @return True if the name is a known strategy, false otherwise.
+   */
+  inline bool ParseStrategy(const std::string& name, Strategy& strategy) {
+    if (name == "flat") strategy = flat;
+    else if (name == "martingale") strategy = martingale;
+    else if (name == "dalembert") strategy = dalembert;
+    else return false;
+    return true;
+  }
+
+  /**
+   * @brief The rules of a simulated session.
+   */
+  struct SessionConfig {
+    Strategy strategy{flat};
+    int bet{-1};              // The index of the bet in the catalog played every spin.
+    int64_t bankroll{100};    // The money at the start of the session.
+    int64_t base_stake{1};    // The first stake, and the minimum stake of the table.
+    int64_t target{200};      // The session stops when the bankroll reaches it.
+    int64_t max_spins{1000};  // The session stops after this many spins.
+  };
+
+  /**
+   * @brief The next stake of a strategy after a spin.
+   *
+   * @param config The rules of the session.
+   * @param stake The stake of the last spin.
+   * @param won True if the last spin won.
+   */
+  inline int64_t NextStake(const SessionConfig& config, const int64_t stake, const bool won) {
+    switch (config.strategy) {
+      case martingale:
+        return won ? config.base_stake : 2 * stake;
+      case dalembert:
+        return won ? std::max(config.base_stake, stake - config.base_stake) : stake + config.base_stake;
+      default:
+        return config.base_stake;
+    }
+  }
+
+  /**
+   * @brief Aggregates of many sessions, mergeable so every thread keeps its own.
+   */
+  struct SimulationStats {
+    uint64_t sessions{0};
+    uint64_t ruined{0};         // Sessions that could no longer cover the minimum stake.
+    uint64_t reached_target{0}; // Sessions that stopped at the target.
+    RunningStats length;        // Spins per session.
+    RunningStats final_bankroll;
+    QuantileSketch length_quantiles;
+    QuantileSketch bankroll_quantiles;
+
+    void Merge(const SimulationStats& other) {
+      sessions += other.sessions;
+      ruined += other.ruined;
+      reached_target += other.reached_target;
+      length.Merge(other.length);
+      final_bankroll.Merge(other.final_bankroll);
+      length_quantiles.Merge(other.length_quantiles);
+      bankroll_quantiles.Merge(other.bankroll_quantiles);
+    }
+  };
+
+  /**
+   * @brief Plays one session and adds its result to the stats.
+   *
+   * @param config The rules of the session.
+   * @param spin Returns the number of a new spin of the wheel.
+   * @param stats The stats where the session is recorded.
+   */
+  template <typename Spin>
+  void SimulateSession(const SessionConfig& config, Spin& spin, SimulationStats& stats) {
+    const BetType& bet = Catalog()[config.bet];
+    int64_t bankroll{config.bankroll}, stake{config.base_stake}, spins{0};
+    while (spins < config.max_spins && bankroll >= config.base_stake && bankroll < config.target) {
+      // The stake is capped by what is left, as a real player would do
+      stake = std::min(stake, bankroll);
+      const bool won{((bet.mask >> spin()) & 1) != 0};
+      bankroll += won ? stake * bet.payout : -stake;
+      stake = NextStake(config, stake, won);
+      ++spins;
+    }
+    ++stats.sessions;
+    if (bankroll < config.base_stake) ++stats.ruined;
+    if (bankroll >= config.target) ++stats.reached_target;
+    stats.length.Add(static_cast<double>(spins));
+    stats.final_bankroll.Add(static_cast<double>(bankroll));
+    stats.length_quantiles.Add(static_cast<double>(spins));
+    stats.bankroll_quantiles.Add(static_cast<double>(bankroll));
+  }
+
+  /**
+   * @brief Runs many sessions in parallel without storing any of them.
+   *
+   * @param config The rules of every session.
+   * @param num_sessions The number of sessions to play.
+   * @param spin Returns the number of a new spin, must be safe to call from several threads.
+   * @return The merged stats of every session.
+   */
+  template <typename Spin>
+  SimulationStats Simulate(const SessionConfig& config, const uint64_t num_sessions, Spin spin) {
+    return Parallel::Accumulate<SimulationStats>(
+        num_sessions, [&config, &spin](SimulationStats& stats, uint64_t begin, uint64_t end, unsigned) {
+          Spin thread_spin{spin};
+          for (uint64_t session{begin}; session < end; ++session) SimulateSession(config, thread_spin, stats);
+        });
+  }
+}
+
+#endif // STRATEGY_SIMULATOR_H
@@ -0,0 +1,200 @@
+// Plays random games against the server from many connections at once.
+//
+//   load_generator [--socket path | --port n] [--clients n] [--seconds s] [--games a,b,...]
+//
+// Every client starts a game, plays a random legal move on each TURN and
+// starts another game on OVER, with one request in flight at a time.
+// Prints the games and moves per second the server sustained.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/random.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Client {
+  int fd{-1};
+  std::string input;
+  std::string game;
+  Clock::time_point sent;
+};
+
+struct Totals {
+  uint64_t games{0}, moves{0}, errors{0}, replies{0};
+  double latency_seconds{0};
+  std::map<std::string, std::map<std::string, uint64_t>> outcomes; // game, then win, loss or draw
+};
+
+std::vector<std::string> Split(const std::string& text, const char separator) {
+  std::vector<std::string> parts;
+  std::istringstream stream(text);
+  std::string part;
+  while (std::getline(stream, part, separator)) parts.push_back(part);
+  return parts;
+}
+
+/**
+ * @brief Connects to the server.
+ *
+ * @return The nonblocking socket, -1 on error.
+ */
+int Connect(const std::string& socket_path, const int port) {
+  int fd;
+  int result;
+  if (port > 0) {
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    int one{1};
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  } else {
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  }
+  if (result < 0) {
+    close(fd);
+    return -1;
+  }
+  int one{1};
+  ioctl(fd, FIONBIO, &one);
+  return fd;
+}
+
+void Send(Client& client, const std::string& request) {
+  client.sent = Clock::now();
+  // The requests are tiny and one at a time, the socket buffer always takes them
+  if (write(client.fd, request.data(), request.size()) < 0) {}
+}
+
+void NewGame(Client& client, const std::vector<std::string>& games) {
+  client.game = games[GetRandomNum(0, static_cast<int>(games.size()) - 1)];
+  Send(client, "NEW " + client.game + "\n");
+}
+
+/**
+ * @brief Answers a reply of the server.
+ */
+void OnReply(Client& client, const std::string& reply, const std::vector<std::string>& games, Totals& totals) {
+  ++totals.replies;
+  totals.latency_seconds += std::chrono::duration<double>(Clock::now() - client.sent).count();
+  std::istringstream words(reply);
+  std::string kind, word;
+  words >> kind;
+  if (kind == "TURN") {
+    while (words >> word && word.rfind("legal=", 0) != 0) {}
+    const std::vector<std::string> legal{Split(word.substr(6), ',')};
+    if (!legal.empty()) {
+      ++totals.moves;
+      Send(client, "MOVE " + legal[GetRandomNum(0, static_cast<int>(legal.size()) - 1)] + "\n");
+      return;
+    }
+  } else if (kind == "OVER") {
+    words >> word;
+    ++totals.games;
+    ++totals.outcomes[client.game][word];
+  } else {
+    ++totals.errors;
+  }
+  NewGame(client, games);
+}
+
+int main(int argc, char* argv[]) {
+  std::string socket_path{"/tmp/cpp_games.sock"};
+  int port{0};
+  int num_clients{1000};
+  double duration{10};
+  std::vector<std::string> games{"tictactoe", "connect_four", "jajanken", "hangman"};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socket_path = argv[++i];
+    else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) port = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--clients") == 0 && i + 1 < argc) num_clients = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) duration = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = Split(argv[++i], ',');
+  }
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < static_cast<rlim_t>(num_clients) + 64) {
+    limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, num_clients + 64);
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  signal(SIGPIPE, SIG_IGN);
+  const int epoll_fd{epoll_create1(EPOLL_CLOEXEC)};
+  std::vector<Client> clients(num_clients);
+  for (int c{0}; c < num_clients; ++c) {
+    clients[c].fd = Connect(socket_path, port);
+    if (clients[c].fd < 0) {
+      std::cerr << "Could not connect client " << c << ": " << std::strerror(errno) << std::endl;
+      return 1;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u32 = c;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, clients[c].fd, &event);
+  }
+  Totals totals;
+  const auto start = Clock::now();
+  for (Client& client : clients) NewGame(client, games);
+  std::vector<epoll_event> events(1024);
+  int open_clients{num_clients};
+  while (open_clients > 0 && Clock::now() - start < std::chrono::duration<double>(duration)) {
+    const int count{epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), 100)};
+    for (int i{0}; i < count; ++i) {
+      Client& client{clients[events[i].data.u32]};
+      char buffer[4096];
+      ssize_t received;
+      while ((received = read(client.fd, buffer, sizeof(buffer))) > 0) client.input.append(buffer, received);
+      if (received == 0) {
+        std::cerr << "The server closed a connection" << std::endl;
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, client.fd, nullptr);
+        --open_clients;
+        continue;
+      }
+      size_t end;
+      while ((end = client.input.find('\n')) != std::string::npos) {
+        const std::string reply{client.input.substr(0, end)};
+        client.input.erase(0, end + 1);
+        OnReply(client, reply, games, totals);
+      }
+    }
+  }
+  const double seconds{std::chrono::duration<double>(Clock::now() - start).count()};
+  for (Client& client : clients) close(client.fd);
+  std::cout << std::fixed << std::setprecision(0) << num_clients << " clients for " << seconds << " s: "
+            << totals.games / seconds << " games/s, " << totals.moves / seconds << " moves/s, "
+            << std::setprecision(1) << 1e6 * totals.latency_seconds / std::max<uint64_t>(totals.replies, 1)
+            << " us mean round trip, " << totals.errors << " errors\n";
+  for (const auto& [game, outcomes] : totals.outcomes) {
+    std::cout << "  " << std::left << std::setw(14) << game << std::right;
+    for (const auto& [outcome, count] : outcomes) std::cout << " " << outcome << " " << count;
+    std::cout << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,378 @@
+// Hosts many games at once over a local socket.
+//
+//   server [--socket path | --port n] [--max-sessions n] [--workers n] [--words file]
+//
+// Listens on a Unix domain socket (/tmp/cpp_games.sock by default) or on a
+// loopback TCP port. The protocol is described in session.h; try it with
+//   nc -U /tmp/cpp_games.sock
+// One thread runs an epoll event loop over every connection, the AI moves
+// run on a pool of workers. Sessions live in a slab allocated at startup,
+// buffers and AI included, so every session takes the same memory.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "../common/word_file.h"
+#include "session.h"
+#include "slab.h"
+#include "worker_pool.h"
+
+// Tags of the epoll events that are not connections
+const uint64_t kListenTag{~0ULL - 1}, kWorkerTag{~0ULL - 2};
+
+volatile std::sig_atomic_t stop{0};
+
+// A request can't be longer, a client sending one is closed
+const size_t kMaxLine{1024};
+// With this much output waiting the requests stay in the socket until the client reads
+const size_t kOutputHighWater{1024};
+// Room for the high water mark and the longest reply
+const size_t kOutputSize{2048};
+const size_t kMaxReply{kOutputSize - kOutputHighWater};
+
+struct Connection {
+  int fd{-1};
+  Protocol::Session session;
+  char input[kMaxLine];     // Received bytes that are not a whole line yet.
+  size_t input_size{0};
+  char output[kOutputSize]; // Bytes waiting to be sent.
+  size_t output_size{0};
+  char reply[kMaxReply];    // Written by the AI job, sent by the event loop.
+  size_t reply_size{0};
+  bool busy{false};         // A worker owns the session until its AI move is done.
+  bool closing{false};      // Close as soon as the worker and the output are done.
+  bool end_of_input{false}; // The client sent everything, answer its lines and close.
+  uint32_t events{0};       // The epoll events registered.
+};
+
+class Server {
+ public:
+  Server(const int listen_fd, const uint32_t max_sessions, const unsigned num_workers, Protocol::Games& games)
+      : listen_fd_(listen_fd), epoll_fd_(epoll_create1(EPOLL_CLOEXEC)), connections_(max_sessions),
+        workers_(num_workers), games_(games) {
+    Watch(listen_fd_, EPOLLIN, kListenTag, EPOLL_CTL_ADD);
+    Watch(workers_.EventFd(), EPOLLIN, kWorkerTag, EPOLL_CTL_ADD);
+  }
+
+  void Run() {
+    std::vector<epoll_event> events(1024);
+    std::vector<uint64_t> completed;
+    auto last_report = std::chrono::steady_clock::now();
+    uint64_t last_moves{0};
+    while (!stop) {
+      const int count{epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), 1000)};
+      if (count < 0 && errno != EINTR) break;
+      for (int i{0}; i < count; ++i) {
+        const uint64_t tag{events[i].data.u64};
+        if (tag == kListenTag) {
+          Accept();
+        } else if (tag == kWorkerTag) {
+          workers_.TakeCompleted(completed);
+          for (const uint64_t handle : completed) AiDone(handle);
+        } else {
+          Connection* connection{connections_.Get(tag)};
+          if (!connection) continue;
+          if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+            // Reported even while not reading, the client is gone both ways
+            Gone(*connection);
+            Flush(tag, *connection);
+          } else {
+            if (events[i].events & EPOLLIN) Read(tag, *connection);
+            if ((events[i].events & EPOLLOUT) && connections_.Get(tag)) Flush(tag, *connection);
+          }
+        }
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now - last_report >= std::chrono::seconds(5)) {
+        const double seconds{std::chrono::duration<double>(now - last_report).count()};
+        std::cout << connections_.InUse() << " sessions, " << games_started_ << " games started, "
+                  << static_cast<uint64_t>((moves_ - last_moves) / seconds) << " moves/s" << std::endl;
+        last_report = now;
+        last_moves = moves_;
+      }
+    }
+    std::cout << "Served " << games_started_ << " games and " << moves_ << " moves" << std::endl;
+  }
+
+ private:
+  void Watch(const int fd, const uint32_t events, const uint64_t tag, const int operation) {
+    epoll_event event{};
+    event.events = events;
+    event.data.u64 = tag;
+    epoll_ctl(epoll_fd_, operation, fd, &event);
+  }
+
+  void Accept() {
+    while (true) {
+      const int fd{accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)};
+      if (fd < 0) return;
+      const uint64_t handle{connections_.Allocate()};
+      if (handle == Slab<Connection>::kNone) {
+        const char full[]{"ERR server full\n"};
+        if (write(fd, full, sizeof(full) - 1) < 0) {}
+        close(fd);
+        continue;
+      }
+      int one{1};
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+      Connection* connection{connections_.Get(handle)};
+      connection->fd = fd;
+      connection->events = kReadEvents;
+      Watch(fd, kReadEvents, handle, EPOLL_CTL_ADD);
+    }
+  }
+
+  static constexpr uint32_t kReadEvents{EPOLLIN | EPOLLRDHUP};
+
+  // Requests are read only while they can be answered
+  static bool Readable(const Connection& connection) {
+    return !connection.closing && !connection.end_of_input && connection.output_size < kOutputHighWater &&
+           connection.input_size < kMaxLine;
+  }
+
+  // The client is gone, stop serving it while a worker may still own the session
+  static void Gone(Connection& connection) {
+    connection.closing = true;
+    connection.output_size = 0;
+  }
+
+  void Read(const uint64_t handle, Connection& connection) {
+    while (Readable(connection)) {
+      const ssize_t count{read(connection.fd, connection.input + connection.input_size,
+                               kMaxLine - connection.input_size)};
+      if (count > 0) {
+        connection.input_size += count;
+        Process(handle, connection);
+        continue;
+      }
+      if (count < 0 && errno == EINTR) continue;
+      if (count == 0) {
+        // A half close still gets the replies to what was sent before it
+        connection.end_of_input = true;
+        Process(handle, connection);
+      } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        Gone(connection);
+      }
+      break;
+    }
+    Flush(handle, connection);
+  }
+
+  static void Append(Connection& connection, const char* reply, const size_t size) {
+    // Replies are much shorter than the room above the high water mark
+    if (connection.output_size + size > kOutputSize) {
+      Gone(connection);
+      return;
+    }
+    std::memcpy(connection.output + connection.output_size, reply, size);
+    connection.output_size += size;
+  }
+
+  static void Append(Connection& connection, const std::string& reply) {
+    Append(connection, reply.data(), reply.size());
+  }
+
+  /**
+   * @brief Answers the whole lines received, stopping while the AI plays or
+   *        the output is over the high water mark.
+   */
+  void Process(const uint64_t handle, Connection& connection) {
+    size_t begin{0};
+    while (!connection.busy && !connection.closing && connection.output_size < kOutputHighWater) {
+      const char* newline{static_cast<const char*>(
+          std::memchr(connection.input + begin, '\n', connection.input_size - begin))};
+      if (!newline) break;
+      std::string line(connection.input + begin, newline - connection.input - begin);
+      begin = newline - connection.input + 1;
+      if (!line.empty() && line.back() == '\r') line.pop_back();
+      if (line == "QUIT") {
+        connection.closing = true;
+        break;
+      }
+      if (line.rfind("NEW ", 0) == 0) ++games_started_;
+      if (line.rfind("MOVE ", 0) == 0) ++moves_;
+      bool needs_ai{false};
+      Append(connection, Protocol::Handle(games_, connection.session, line, generator_, needs_ai));
+      if (needs_ai) {
+        connection.busy = true;
+        Connection* ai_connection{&connection};
+        const Protocol::Games* games{&games_};
+        workers_.Submit(handle, [ai_connection, games] {
+          static thread_local std::mt19937 worker_generator(std::random_device{}());
+          const std::string reply{Protocol::PlayAi(*games, ai_connection->session, worker_generator)};
+          // Replies are much shorter than the buffer
+          ai_connection->reply_size = std::min(reply.size(), kMaxReply);
+          std::memcpy(ai_connection->reply, reply.data(), ai_connection->reply_size);
+        });
+      }
+    }
+    connection.input_size -= begin;
+    std::memmove(connection.input, connection.input + begin, connection.input_size);
+    // A full buffer without a line break can never become a request
+    if (!connection.closing && connection.input_size == kMaxLine &&
+        !std::memchr(connection.input, '\n', connection.input_size)) {
+      Append(connection, "ERR line too long\n");
+      connection.closing = true;
+    }
+    if (connection.end_of_input && !connection.busy && !std::memchr(connection.input, '\n', connection.input_size))
+      connection.closing = true;
+  }
+
+  void AiDone(const uint64_t handle) {
+    Connection* connection{connections_.Get(handle)};
+    if (!connection) return;
+    connection->busy = false;
+    if (!connection->closing) Append(*connection, connection->reply, connection->reply_size);
+    Process(handle, *connection);
+    Flush(handle, *connection);
+  }
+
+  /**
+   * @brief Sends what it can, answering the requests held back meanwhile,
+   *        and listens for what the connection is ready for.
+   */
+  void Flush(const uint64_t handle, Connection& connection) {
+    while (true) {
+      size_t sent{0};
+      while (sent < connection.output_size) {
+        const ssize_t count{write(connection.fd, connection.output + sent, connection.output_size - sent)};
+        if (count > 0) {
+          sent += count;
+        } else if (count < 0 && errno == EINTR) {
+          continue;
+        } else {
+          if (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            Gone(connection);
+            sent = 0;
+          }
+          break;
+        }
+      }
+      connection.output_size -= sent;
+      std::memmove(connection.output, connection.output + sent, connection.output_size);
+      const size_t before{connection.output_size};
+      if (sent == 0 || connection.output_size >= kOutputHighWater) break;
+      Process(handle, connection);
+      if (connection.output_size == before) break;
+    }
+    uint32_t events{Readable(connection) ? kReadEvents : 0u};
+    if (connection.output_size > 0) events |= EPOLLOUT;
+    if (events != connection.events) {
+      connection.events = events;
+      Watch(connection.fd, events, handle, EPOLL_CTL_MOD);
+    }
+    if (connection.closing && !connection.busy && connection.output_size == 0) Close(handle, connection);
+  }
+
+  void Close(const uint64_t handle, Connection& connection) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection.fd, nullptr);
+    // Unread bytes would reset the connection and lose the last reply
+    char discard[256];
+    while (read(connection.fd, discard, sizeof(discard)) > 0) {}
+    close(connection.fd);
+    connections_.Free(handle);
+  }
+
+  int listen_fd_;
+  int epoll_fd_;
+  Slab<Connection> connections_;
+  WorkerPool workers_;
+  Protocol::Games& games_;
+  std::mt19937 generator_{std::random_device{}()};
+  uint64_t games_started_{0};
+  uint64_t moves_{0};
+};
+
+/**
+ * @brief Opens the listening socket.
+ *
+ * @return The socket, -1 on error.
+ */
+int Listen(const std::string& socket_path, const int port) {
+  int fd;
+  if (port > 0) {
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one{1};
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) return -1;
+  } else {
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(socket_path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) return -1;
+  }
+  return listen(fd, SOMAXCONN) < 0 ? -1 : fd;
+}
+
+int main(int argc, char* argv[]) {
+  std::string socket_path{"/tmp/cpp_games.sock"}, words_file{"hangman/hangman_en.txt"};
+  int port{0};
+  uint32_t max_sessions{10000};
+  unsigned num_workers{Parallel::NumThreads()};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socket_path = argv[++i];
+    else if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) port = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--max-sessions") == 0 && i + 1 < argc) max_sessions = std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) num_workers = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--words") == 0 && i + 1 < argc) words_file = argv[++i];
+  }
+  // Words that fit in a string's own buffer, so a hangman match never allocates
+  std::vector<std::string> words;
+  for (std::string& word : ReadWordsFromFile(words_file))
+    if (word.size() <= std::string().capacity()) words.push_back(std::move(word));
+  if (words.empty()) {
+    std::cerr << "Could not read " << words_file << ", run from the root of the repository" << std::endl;
+    return 1;
+  }
+  // Every session needs a file descriptor
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < max_sessions + 64) {
+    limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, max_sessions + 64);
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  signal(SIGPIPE, SIG_IGN);
+  struct sigaction on_stop{};
+  on_stop.sa_handler = [](int) { stop = 1; };
+  sigaction(SIGINT, &on_stop, nullptr);
+  sigaction(SIGTERM, &on_stop, nullptr);
+  const int listen_fd{Listen(socket_path, port)};
+  if (listen_fd < 0) {
+    std::cerr << "Could not listen: " << std::strerror(errno) << std::endl;
+    return 1;
+  }
+  Protocol::Games games{{}, {}, {}, HangmanGame(std::move(words))};
+  std::cout << "Listening on " << (port > 0 ? "127.0.0.1:" + std::to_string(port) : socket_path) << " with "
+            << max_sessions << " session slots, " << sizeof(Connection) << " bytes each ("
+            << max_sessions * sizeof(Connection) / (1 << 20) << " MB), and " << num_workers << " AI workers"
+            << std::endl;
+  Server server(listen_fd, max_sessions, num_workers, games);
+  server.Run();
+  close(listen_fd);
+  if (port == 0) unlink(socket_path.c_str());
+}
@@ -0,0 +1,211 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../common/engine.h"
+#include "../connect_four/connect_four_engine.h"
+#include "../hangman/hangman_engine.h"
+#include "../jajanken/jajanken_engine.h"
+#include "../jajanken/pattern_predictor.h"
+#include "../tictactoe/tictactoe_engine.h"
+
+/**
+ * The line based protocol of the game server.
+ *
+ * Requests, one per line:
+ *   NEW <tictactoe|connect_four|jajanken|hangman>   Starts a game, the client is player 0.
+ *   MOVE <action>                                    Plays an action, as listed in `legal=`.
+ *   QUIT                                             Closes the connection.
+ *
+ * Every request gets one line back:
+ *   TURN [ai=<action>] legal=<a,b,...> <board>       The client plays next.
+ *   OVER <win|loss|draw> [ai=<action>] <board>       The game ended.
+ *   ERR <message>
+ * The board is the game's own rendering with its line breaks shown as '|'.
+ */
+namespace Protocol {
+  using ConnectFour = ConnectFourGame;
+  using TicTacToe = TicTacToeGame;
+  using Jajanken3 = Jajanken::Game<3>;
+
+  // One instance of every game, shared read only by every session
+  using Games = std::tuple<ConnectFour, TicTacToe, Jajanken3, HangmanGame>;
+
+  // A match lasts a few rounds, 64 contexts per predictor are plenty: 4 KB instead of 256 KB
+  const int kJajankenTableBits{6};
+
+  /**
+   * @brief What the AI of a game remembers between its moves, nothing for the
+   *        greedy players of the board games.
+   */
+  template <typename Game>
+  struct AiState {};
+
+  template <>
+  struct AiState<Jajanken3> {
+    PatternPredictor<3, kJajankenTableBits> predictor;
+    uint64_t seen{0}; // Rounds already learnt from.
+  };
+
+  /**
+   * @brief A game in progress against the AI of the server.
+   *
+   * Both the state and the AI are held by value, so a match never allocates.
+   */
+  template <typename Game>
+  struct Match {
+    using GameType = Game;
+    typename Game::State state;
+    AiState<Game> ai;
+  };
+
+  /**
+   * @brief Everything the server keeps about a client.
+   *
+   * The size is the same for every game, so sessions fit in a slab.
+   */
+  struct Session {
+    std::variant<std::monostate, Match<ConnectFour>, Match<TicTacToe>, Match<Jajanken3>, Match<HangmanGame>> match;
+  };
+
+  inline std::string Board(std::string render) {
+    while (!render.empty() && render.back() == '\n') render.pop_back();
+    for (char& c : render)
+      if (c == '\n') c = '|';
+    return render;
+  }
+
+  /**
+   * @brief The reply describing the state of a match.
+   */
+  template <typename Game>
+  std::string Describe(const Game& game, const Match<Game>& match, const std::string& ai_action) {
+    const std::string ai{ai_action.empty() ? "" : "ai=" + ai_action + " "};
+    if (game.IsTerminal(match.state)) {
+      const double outcome{game.Outcome(match.state, 0)};
+      return std::string("OVER ") + (outcome == 1 ? "win " : outcome == 0 ? "loss " : "draw ") + ai +
+             Board(game.Render(match.state)) + "\n";
+    }
+    std::vector<typename Game::Action> actions;
+    game.LegalActions(match.state, actions);
+    std::string reply{"TURN " + ai + "legal="};
+    for (size_t i{0}; i < actions.size(); ++i) reply += (i ? "," : "") + game.ActionName(actions[i]);
+    return reply + " " + Board(game.Render(match.state)) + "\n";
+  }
+
+  template <typename Game>
+  Match<Game> NewMatch(const Game& game, std::mt19937& generator) {
+    return {game.Initial(generator), {}};
+  }
+
+  /**
+   * @brief The action of the AI in a board game.
+   */
+  template <typename Game>
+  typename Game::Action AiAction(const Game& game, Match<Game>& match, std::mt19937& generator) {
+    // The greedy player keeps nothing between moves, one per worker serves every session
+    static thread_local Engine::GreedyAgent<Game> agent;
+    return agent.Act(game, match.state, generator);
+  }
+
+  /**
+   * @brief The throw of the AI in Jajanken, the counter of what the client is
+   *        expected to throw.
+   */
+  inline int AiAction(const Jajanken3&, Match<Jajanken3>& match, std::mt19937& generator) {
+    const auto& state = match.state;
+    // The AI plays every round, it never misses more than the kept ones
+    for (match.ai.seen = std::max(match.ai.seen, state.FirstRecent()); match.ai.seen < state.num_rounds;
+         ++match.ai.seen)
+      match.ai.predictor.Update(state.Round(match.ai.seen).first, state.Round(match.ai.seen).second);
+    return PatternPredictor<3, kJajankenTableBits>::CounterMove(match.ai.predictor.Predict(),
+                                                                Jajanken::Rules<3>::CheckWin, generator);
+  }
+
+  /**
+   * @brief Plays the action of the client.
+   */
+  template <typename Game>
+  std::string PlayClient(const Game& game, Match<Game>& match, const std::string& text, bool& needs_ai) {
+    if (game.IsTerminal(match.state)) return "ERR game over\n";
+    typename Game::Action action;
+    if (!game.ParseAction(text, action)) return "ERR unknown action\n";
+    std::vector<typename Game::Action> actions;
+    game.LegalActions(match.state, actions);
+    if (std::find(actions.begin(), actions.end(), action) == actions.end()) return "ERR illegal action\n";
+    match.state = game.Apply(match.state, action);
+    needs_ai = !game.IsTerminal(match.state) && game.CurrentPlayer(match.state) != 0;
+    return needs_ai ? "" : Describe(game, match, "");
+  }
+
+  /**
+   * @brief Handles a request of the client.
+   *
+   * @param needs_ai Set if it is the AI's turn, then the reply comes from `PlayAi`.
+   * @return The reply, empty if the AI has to play first.
+   */
+  inline std::string Handle(const Games& games, Session& session, const std::string& line, std::mt19937& generator,
+                            bool& needs_ai) {
+    needs_ai = false;
+    const size_t space{line.find(' ')};
+    const std::string command{line.substr(0, space)};
+    const std::string argument{space == std::string::npos ? "" : line.substr(space + 1)};
+    if (command == "NEW") {
+      if (argument == "connect_four") session.match = NewMatch(std::get<ConnectFour>(games), generator);
+      else if (argument == "tictactoe") session.match = NewMatch(std::get<TicTacToe>(games), generator);
+      else if (argument == "jajanken") session.match = NewMatch(std::get<Jajanken3>(games), generator);
+      else if (argument == "hangman") session.match = NewMatch(std::get<HangmanGame>(games), generator);
+      else return "ERR unknown game\n";
+    } else if (command != "MOVE") {
+      return "ERR unknown command\n";
+    }
+    return std::visit([&](auto& match) -> std::string {
+      using MatchType = std::decay_t<decltype(match)>;
+      if constexpr (std::is_same_v<MatchType, std::monostate>) {
+        return "ERR no game\n";
+      } else {
+        const auto& game = std::get<typename MatchType::GameType>(games);
+        if (command == "NEW") return Describe(game, match, "");
+        return PlayClient(game, match, argument, needs_ai);
+      }
+    }, session.match);
+  }
+
+  /**
+   * @brief Plays the turns of the AI.
+   *
+   * Runs on a worker, the event loop leaves the session alone meanwhile.
+   *
+   * @return The reply.
+   */
+  inline std::string PlayAi(const Games& games, Session& session, std::mt19937& generator) {
+    return std::visit([&](auto& match) -> std::string {
+      using MatchType = std::decay_t<decltype(match)>;
+      if constexpr (!std::is_same_v<MatchType, std::monostate>) {
+        const auto& game = std::get<typename MatchType::GameType>(games);
+        std::string ai_actions;
+        if constexpr (MatchType::GameType::kNumPlayers == 2) {
+          while (!game.IsTerminal(match.state) && game.CurrentPlayer(match.state) != 0) {
+            const auto action = AiAction(game, match, generator);
+            ai_actions += (ai_actions.empty() ? "" : ",") + game.ActionName(action);
+            match.state = game.Apply(match.state, action);
+          }
+        }
+        return Describe(game, match, ai_actions);
+      } else {
+        return "";
+      }
+    }, session.match);
+  }
+}
+
+#endif // SESSION_H
@@ -0,0 +1,68 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A fixed number of objects allocated once and reused.
+ *
+ * Objects are addressed by a handle that packs the slot and a generation,
+ * so a stale handle (e.g. a reply for a connection that was closed and
+ * whose slot was reused) is detected instead of reaching the wrong object.
+ * The memory never grows after construction.
+ */
+template <typename T>
+class Slab {
+ public:
+  static constexpr uint64_t kNone{~0ULL};
+
+  explicit Slab(const uint32_t capacity) : objects_(capacity), generations_(capacity, 0), used_(capacity, false) {
+    free_.reserve(capacity);
+    for (uint32_t slot{capacity}; slot > 0; --slot) free_.push_back(slot - 1);
+  }
+
+  /**
+   * @brief Takes a free object, reset to its default state.
+   *
+   * @return Its handle, `kNone` if every object is in use.
+   */
+  uint64_t Allocate() {
+    if (free_.empty()) return kNone;
+    const uint32_t slot{free_.back()};
+    free_.pop_back();
+    objects_[slot] = T{};
+    used_[slot] = true;
+    return Handle(slot);
+  }
+
+  void Free(const uint64_t handle) {
+    const uint32_t slot{Slot(handle)};
+    used_[slot] = false;
+    ++generations_[slot];
+    free_.push_back(slot);
+  }
+
+  /**
+   * @brief The object of a handle, nullptr if it was freed since.
+   */
+  T* Get(const uint64_t handle) {
+    const uint32_t slot{Slot(handle)};
+    if (slot >= objects_.size() || !used_[slot] || generations_[slot] != (handle >> 32)) return nullptr;
+    return &objects_[slot];
+  }
+
+  uint32_t Capacity() const { return static_cast<uint32_t>(objects_.size()); }
+  uint32_t InUse() const { return Capacity() - static_cast<uint32_t>(free_.size()); }
+
+ private:
+  uint64_t Handle(const uint32_t slot) const { return static_cast<uint64_t>(generations_[slot]) << 32 | slot; }
+  static uint32_t Slot(const uint64_t handle) { return static_cast<uint32_t>(handle); }
+
+  std::vector<T> objects_;
+  std::vector<uint32_t> generations_;
+  std::vector<bool> used_;
+  std::vector<uint32_t> free_;
+};
+
+#endif // SLAB_H
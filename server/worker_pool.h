@@ -0,0 +1,101 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs jobs off the event loop and reports them back through an eventfd.
+ *
+ * A job works on data the event loop does not touch until the job is done.
+ * When it finishes its tag goes to the completion queue and the eventfd
+ * becomes readable, so the loop picks it up with the rest of its events.
+ */
+class WorkerPool {
+ public:
+  explicit WorkerPool(const unsigned num_threads) : event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    for (unsigned t{0}; t < num_threads; ++t) threads_.emplace_back([this] { Work(); });
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) thread.join();
+    close(event_fd_);
+  }
+
+  /**
+   * @brief The eventfd that is readable while there are completions.
+   */
+  int EventFd() const { return event_fd_; }
+
+  void Submit(const uint64_t tag, std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back({tag, std::move(job)});
+    }
+    wake_.notify_one();
+  }
+
+  /**
+   * @brief Takes the tags of every finished job.
+   */
+  void TakeCompleted(std::vector<uint64_t>& tags) {
+    uint64_t count;
+    while (read(event_fd_, &count, sizeof(count)) == sizeof(count)) {}
+    tags.clear();
+    std::lock_guard<std::mutex> lock(completed_mutex_);
+    tags.swap(completed_);
+  }
+
+ private:
+  struct Job {
+    uint64_t tag;
+    std::function<void()> run;
+  };
+
+  void Work() {
+    while (true) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) return;
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      job.run();
+      {
+        std::lock_guard<std::mutex> lock(completed_mutex_);
+        completed_.push_back(job.tag);
+      }
+      const uint64_t one{1};
+      if (write(event_fd_, &one, sizeof(one)) != sizeof(one)) {}
+    }
+  }
+
+  int event_fd_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<Job> jobs_;
+  bool stopping_{false};
+  std::mutex completed_mutex_;
+  std::vector<uint64_t> completed_;
+  std::vector<std::thread> threads_;
+};
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,76 @@
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <random>
+#include <vector>
+
+/**
+ * @brief Walker's alias table for O(1) draws from a discrete weighted distribution.
+ *
+ * Built once in O(n) with Vose's method: every column holds its own outcome
+ * with probability `probability_[i]` and the `alias_[i]` outcome otherwise.
+ */
+class AliasTable {
+ public:
+  AliasTable() = default;
+
+  /**
+   * @brief Builds the table for the given weights.
+   *
+   * @param weights The non-negative weight of every outcome, at least one must be positive.
+   */
+  explicit AliasTable(const std::vector<double>& weights)
+      : probability_(weights.size()), alias_(weights.size()), distribution_(weights.size()) {
+    const int n{static_cast<int>(weights.size())};
+    double total{0};
+    for (const double weight : weights) total += weight;
+    std::vector<double> scaled(n);
+    std::vector<int> small, large;
+    for (int i{0}; i < n; ++i) {
+      distribution_[i] = weights[i] / total;
+      scaled[i] = distribution_[i] * n;
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+      const int less{small.back()}, more{large.back()};
+      small.pop_back();
+      probability_[less] = scaled[less];
+      alias_[less] = more;
+      scaled[more] -= 1.0 - scaled[less];
+      if (scaled[more] < 1.0) {
+        large.pop_back();
+        small.push_back(more);
+      }
+    }
+    // Whatever is left is 1 up to rounding errors
+    for (const int i : large) probability_[i] = 1.0;
+    for (const int i : small) probability_[i] = 1.0;
+  }
+
+  /**
+   * @brief Draws an outcome with one uniform column and one uniform coin.
+   *
+   * @param generator The random generator to use.
+   * @return The index of the outcome.
+   */
+  int Sample(std::mt19937& generator) const {
+    std::uniform_int_distribution<int> column(0, static_cast<int>(alias_.size()) - 1);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    const int i{column(generator)};
+    return coin(generator) < probability_[i] ? i : alias_[i];
+  }
+
+  /**
+   * @brief The exact probability of an outcome, i.e. its normalized weight.
+   */
+  double Probability(const int i) const { return distribution_[i]; }
+
+  int size() const { return static_cast<int>(alias_.size()); }
+
+ private:
+  std::vector<double> probability_;
+  std::vector<int> alias_;
+  std::vector<double> distribution_;
+};
+
+#endif // ALIAS_TABLE_H
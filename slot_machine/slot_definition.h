@@ -0,0 +1,213 @@
+#ifndef SLOT_DEFINITION_H
+#define SLOT_DEFINITION_H
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "alias_table.h"
+
+/**
+ * @brief A reel strip: the symbols in stop order and the alias table to draw a stop.
+ */
+struct Reel {
+  std::vector<int> symbols;    // The symbol of every stop of the strip.
+  std::vector<double> weights; // The weight of landing on every stop.
+  AliasTable stops;            // Draws a stop according to the weights.
+};
+
+/**
+ * @brief The definition of a slot machine: reels, visible rows, paylines and paytable.
+ *
+ * A spin lands every reel on a stop, the reel then shows that stop and the
+ * following ones in `rows` rows. A payline names the row to read on every
+ * reel and pays the run of equal symbols starting at the first reel.
+ */
+struct SlotDefinition {
+  std::vector<std::string> symbols;          // The emoji of every symbol.
+  std::vector<Reel> reels;                   // The strips from left to right.
+  int rows{1};                               // The visible rows of every reel.
+  std::vector<std::vector<int>> paylines;    // The row read on every reel.
+  std::vector<std::vector<double>> paytable; // Pay of [symbol][run length], per unit bet.
+
+  int NumReels() const { return static_cast<int>(reels.size()); }
+
+  /**
+   * @brief The symbol shown at a row of a reel once it stopped.
+   */
+  int SymbolAt(const int reel, const int stop, const int row) const {
+    const std::vector<int>& strip = reels[reel].symbols;
+    return strip[(stop + row) % strip.size()];
+  }
+
+  /**
+   * @brief Draws the stop of every reel, O(1) per reel.
+   *
+   * @param generator The random generator to use.
+   * @return The stop every reel landed on.
+   */
+  std::vector<int> Spin(std::mt19937& generator) const {
+    std::vector<int> stops(reels.size());
+    for (size_t reel{0}; reel < reels.size(); ++reel) stops[reel] = reels[reel].stops.Sample(generator);
+    return stops;
+  }
+
+  /**
+   * @brief Computes what a spin pays over all the paylines.
+   *
+   * @param stops The stop every reel landed on.
+   * @return The total pay, in units of the bet of one line.
+   */
+  double Payout(const std::vector<int>& stops) const {
+    double total{0};
+    for (const auto& line : paylines) {
+      const int first{SymbolAt(0, stops[0], line[0])};
+      int run{1};
+      while (run < NumReels() && SymbolAt(run, stops[run], line[run]) == first) ++run;
+      total += paytable[first][run];
+    }
+    return total;
+  }
+
+  /**
+   * @brief Computes the exact return to player by enumerating every stop combination.
+   *
+   * @return The expected pay per unit wagered, with one unit bet on every line.
+   */
+  double ExactRtp() const {
+    if (paylines.empty()) return 0;
+    std::vector<int> stops(reels.size(), 0);
+    double expected{0};
+    while (true) {
+      double probability{1};
+      for (int reel{0}; reel < NumReels(); ++reel) probability *= reels[reel].stops.Probability(stops[reel]);
+      if (probability > 0) expected += probability * Payout(stops);
+      // Next combination, counting in a mixed radix of the strip lengths
+      int reel{NumReels() - 1};
+      while (reel >= 0 && ++stops[reel] == static_cast<int>(reels[reel].symbols.size())) stops[reel--] = 0;
+      if (reel < 0) break;
+    }
+    return expected / paylines.size();
+  }
+};
+
+/**
+ * @brief Loads a slot machine definition from a file.
+ *
+ * Every line is one of (`#` starts a comment):
+ *   symbol <name> <emoji>
+ *   rows <number of visible rows>
+ *   reel <name>:<weight> <name>:<weight> ...   one line per reel, stops in order
+ *   payline <row of reel 1> <row of reel 2> ...
+ *   pay <name> <run length> <pay per unit bet>
+ *
+ * @param file_name The name of the definition file.
+ * @param slot The definition to fill.
+ * @param error Describes the problem when the file is not valid.
+ * @return True if the definition was loaded, false otherwise.
+ */
+inline bool LoadSlotDefinition(const std::string& file_name, SlotDefinition& slot, std::string& error) {
+  std::ifstream input_file(file_name);
+  if (!input_file.is_open()) {
+    error = "cannot open " + file_name;
+    return false;
+  }
+  std::map<std::string, int> symbol_ids;
+  std::vector<std::vector<std::pair<std::string, double>>> strips;
+  std::vector<std::tuple<std::string, int, double>> pays;
+  std::string line;
+  for (int line_number{1}; std::getline(input_file, line); ++line_number) {
+    std::istringstream line_stream(line.substr(0, line.find('#')));
+    std::string keyword;
+    if (!(line_stream >> keyword)) continue;
+    const std::string where{file_name + ":" + std::to_string(line_number) + ": "};
+    if (keyword == "symbol") {
+      std::string name, emoji;
+      if (!(line_stream >> name >> emoji) || symbol_ids.count(name)) {
+        error = where + "expected a new symbol name and its emoji";
+        return false;
+      }
+      symbol_ids[name] = static_cast<int>(slot.symbols.size());
+      slot.symbols.push_back(emoji);
+    } else if (keyword == "rows") {
+      if (!(line_stream >> slot.rows) || slot.rows < 1) {
+        error = where + "expected a positive number of rows";
+        return false;
+      }
+    } else if (keyword == "reel") {
+      strips.emplace_back();
+      for (std::string stop; line_stream >> stop;) {
+        const size_t colon{stop.find(':')};
+        const double weight{colon == std::string::npos ? 1.0 : std::atof(stop.c_str() + colon + 1)};
+        strips.back().emplace_back(stop.substr(0, colon), weight);
+      }
+    } else if (keyword == "payline") {
+      slot.paylines.emplace_back();
+      for (int row; line_stream >> row;) slot.paylines.back().push_back(row);
+    } else if (keyword == "pay") {
+      std::string name;
+      int run;
+      double pay;
+      if (!(line_stream >> name >> run >> pay)) {
+        error = where + "expected a symbol, a run length and its pay";
+        return false;
+      }
+      pays.emplace_back(name, run, pay);
+    } else {
+      error = where + "unknown keyword " + keyword;
+      return false;
+    }
+  }
+  // Resolve the names once every symbol is known
+  for (const auto& strip : strips) {
+    Reel reel;
+    for (const auto& [name, weight] : strip) {
+      if (!symbol_ids.count(name) || weight < 0) {
+        error = file_name + ": unknown symbol or negative weight in reel: " + name;
+        return false;
+      }
+      reel.symbols.push_back(symbol_ids[name]);
+      reel.weights.push_back(weight);
+    }
+    double total{0};
+    for (const double weight : reel.weights) total += weight;
+    if (total <= 0) {
+      error = file_name + ": every reel needs a stop with positive weight";
+      return false;
+    }
+    reel.stops = AliasTable(reel.weights);
+    slot.reels.push_back(std::move(reel));
+  }
+  if (slot.reels.empty() || slot.paylines.empty()) {
+    error = file_name + ": at least one reel and one payline are needed";
+    return false;
+  }
+  for (const auto& payline : slot.paylines) {
+    if (static_cast<int>(payline.size()) != slot.NumReels()) {
+      error = file_name + ": every payline needs a row for each reel";
+      return false;
+    }
+    for (const int row : payline)
+      if (row < 0 || row >= slot.rows) {
+        error = file_name + ": payline row out of the window";
+        return false;
+      }
+  }
+  slot.paytable.assign(slot.symbols.size(), std::vector<double>(slot.NumReels() + 1, 0.0));
+  for (const auto& [name, run, pay] : pays) {
+    if (!symbol_ids.count(name) || run < 1 || run > slot.NumReels()) {
+      error = file_name + ": invalid pay for " + name;
+      return false;
+    }
+    slot.paytable[symbol_ids[name]][run] = pay;
+  }
+  return true;
+}
+
+#endif // SLOT_DEFINITION_H
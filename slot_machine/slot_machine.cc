@@ -1,103 +1,106 @@
 #include <random>
 #include <chrono>
-#include <thread>
+#include <cstring>
 #include <iostream>
 #include <string>
 
-/**
- * @brief Structure representing a string that is printed slowly with a delay between each character.
- */
-struct SlowlyPrintingString {
-  std::string data; // The string to be printed slowly.
-  long int delay;   // The delay (in milliseconds) between each character.
-};
+#include "slot_definition.h"
+#include "../common/animation.h"
+#include "../common/fairness.h"
+#include "../common/keyboard.h"
 
-/**
- * @brief Overload the << operator to print SlowlyPrintingString objects character by character with a delay.
- *
- * @param os The output stream to print to.
- * @param str The SlowlyPrintingString object to be printed.
- * @return The output stream after printing the SlowlyPrintingString object.
- */
-std::ostream& operator<<(std::ostream& os, const SlowlyPrintingString& str) {
-  for (const auto& c : str.data) {
-    os << c << std::flush;        
-    std::this_thread::sleep_for(std::chrono::milliseconds(str.delay));
-  }
-  return os;
-}
-
-// Initialize the random generator once
-std::mt19937 generator(std::random_device{}());
+// Initialize the random generator once per thread
+thread_local std::mt19937 generator(std::random_device{}());
 
 /**
- * @brief Generate a random integer between min and max (inclusive).
+ * @brief Executes a single round of the game.
+ *        This function draws the stop of every reel, spins the reels so they
+ *        stop one after another on them and pays every winning payline.
  *
- * @param min The minimum value of the random number.
- * @param max The maximum value of the random number.
- * @return A random integer between min and max.
+ * @param slot The definition of the slot machine.
+ * @return The pay of the round, in units of the bet of one line.
  */
-int GetRandom(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
+double GameRound(const SlotDefinition& slot) {
+  const std::vector<int> stops{slot.Spin(generator)};
+  const int frames_per_reel{8};
+  Animation::Scheduler scheduler(std::chrono::milliseconds(75));
+  std::cout << '\n';
+  // Every strip scrolls down until its stop frame, then shows its result
+  scheduler.Run(slot.NumReels() * frames_per_reel, [&](const int frame, std::string& buffer) {
+    for (int row{0}; row < slot.rows; ++row) {
+      for (int reel{0}; reel < slot.NumReels(); ++reel) {
+        const int frames_left{std::max(0, (reel + 1) * frames_per_reel - 1 - frame)};
+        buffer += slot.symbols[slot.SymbolAt(reel, stops[reel] + frames_left, row)];
+        if (reel < slot.NumReels() - 1) buffer += " | ";
+      }
+      buffer += '\n';
+    }
+  });
+  return slot.Payout(stops);
 }
 
 /**
- * @brief Emojify function adds an emoji representation of a num to a given message.
- * 
- * @param num The num to be emojified. It should be an integer between 1 and 5.
- * @return The emoji representation of the num.
+ * @brief Checks that spins land on every stop combination with the
+ *        probability given by the reel weights.
+ *
+ * The outcome is the index of the whole combination, so a dependency between
+ * reels fails the chi-square test as well as a badly weighted reel.
+ *
+ * @param slot The definition of the slot machine.
+ * @param num_draws The number of spins to draw.
+ * @return True if every test passed, false otherwise.
  */
-std::string Emojify(const int num) {
-  switch (num) {
-  case 1:
-    return "🍊";
-  case 2:
-    return "🍇";
-  case 3:
-    return "🍋";
-  case 4:
-    return "🍎";
-  case 5:
-    return "🥥";
-  default:
-    return "";
+bool CheckFairness(const SlotDefinition& slot, const uint64_t num_draws) {
+  std::vector<double> probabilities{1.0};
+  for (const Reel& reel : slot.reels) {
+    std::vector<double> combined;
+    for (const double probability : probabilities)
+      for (int stop{0}; stop < reel.stops.size(); ++stop) combined.push_back(probability * reel.stops.Probability(stop));
+    probabilities.swap(combined);
   }
+  return Fairness::Run("slot machine spin", num_draws, probabilities, [&slot] {
+    int combination{0};
+    const std::vector<int> stops{slot.Spin(generator)};
+    for (int reel{0}; reel < slot.NumReels(); ++reel)
+      combination = combination * slot.reels[reel].stops.size() + stops[reel];
+    return combination;
+  });
 }
 
-/**
- * @brief Executes a single round of the game.
- *        This function generates three random numbers between 1 and 5, and then 
- *        converts them into emojis to print the series as a slot machine.
- * @return true if all three numbers are equal (player wins), false otherwise.
- */
-bool GameRound() {
-  const int num1{GetRandom(1, 5)}, num2{GetRandom(1, 5)}, num3{GetRandom(1, 5)};
-  std::cout << '\n' << SlowlyPrintingString{Emojify(num1), 300} << " | ";
-  std::cout << SlowlyPrintingString{Emojify(num2), 300} << " | ";
-  std::cout << SlowlyPrintingString{Emojify(num3), 300} << "\n";
-  return (num1 == num2 && num2 == num3);
-}
-
-int main() {
+int main(int argc, char* argv[]) {
+  Animation::ParseFlags(argc, argv);
+  std::string config_file_name{"slot_machine.cfg"};
+  bool print_rtp{false};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--config") == 0 && i + 1 < argc) config_file_name = argv[++i];
+    else if (std::strcmp(argv[i], "--rtp") == 0) print_rtp = true;
+  }
+  SlotDefinition slot;
+  std::string error;
+  if (!LoadSlotDefinition(config_file_name, slot, error)) {
+    std::cerr << "There was an error loading the slot machine: " << error << std::endl;
+    return 1;
+  }
+  if (print_rtp) {
+    std::cout << "RTP: " << slot.ExactRtp() * 100 << "%" << std::endl;
+    return 0;
+  }
+  if (const uint64_t num_draws{Fairness::ParseFlag(argc, argv)})
+    return CheckFairness(slot, num_draws) ? 0 : 1;
   const bool win{true};
   std::cout << "Let's gamble!\n";
-  char option;
-  std::cin >> option;
-  std::cin.clear();
-  std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  if (tolower(option) == 'n') return 0;
+  // Through the shared reader, the keys typed during a spin are not lost
+  std::string option;
+  if (!Keyboard::input.ReadLine(option) || (!option.empty() && tolower(option[0]) == 'n')) return 0;
   while (true) {
-    if (GameRound() == win) {
-      std::cout << "\nYEAH!" << std::endl;
+    const double pay{GameRound(slot)};
+    if ((pay > 0) == win) {
+      std::cout << "\nYEAH! You win " << pay << " for " << slot.paylines.size() << " lines" << std::endl;
       break;
     } else {
       std::cout << "\nAw, dang it!" << std::endl;
       std::cout << "Do you want to play again? [any letter/n]: ";
-      std::cin >> option;
-      if (tolower(option) == 'n') return 0;
-      std::cin.clear();
-      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      if (!Keyboard::input.ReadLine(option) || (!option.empty() && tolower(option[0]) == 'n')) return 0;
     }
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,149 @@
+#ifndef MNK_AI_H
+#define MNK_AI_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mnk_board.h"
+
+/**
+ * @brief Plays m,n,k games within a time budget per move.
+ *
+ * In order it wins at once, blocks an immediate loss, looks for a win by
+ * continuous fours (threat space search: every attacking move makes a four
+ * the opponent must block, until a move makes two), and otherwise runs an
+ * iterative deepening alpha-beta search over the most promising cells near
+ * the stones until the budget runs out.
+ */
+class MnkAi {
+ public:
+  static constexpr int64_t kWin{int64_t{1} << 40};
+  static_assert(MnkBoard::kMaxEval < kWin / 2, "an evaluation must never look like a win");
+  static constexpr int kMaxThreatDepth{12}; // Fours the attacker may play in a row.
+  static constexpr size_t kBranching{10};    // Cells tried at every node of the search.
+
+  explicit MnkAi(const std::chrono::milliseconds budget) : budget_(budget) {}
+
+  int ChooseMove(MnkBoard& board, const Form form) {
+    const auto start = Clock::now();
+    nodes_ = 0;
+    if (const int cell{board.WinningCell(form)}; cell >= 0) return cell;
+    if (const int cell{board.WinningCell(MnkBoard::Opponent(form))}; cell >= 0) return cell;
+    // Half of the budget for the threat search, the rest for the full search
+    deadline_ = start + budget_ / 2;
+    out_of_time_ = false;
+    int first{-1};
+    for (int depth{1}; depth <= kMaxThreatDepth && !OutOfTime(); ++depth)
+      if (ContinuousFours(board, form, depth, first)) return first;
+    deadline_ = start + budget_;
+    out_of_time_ = false;
+    const std::vector<int> candidates{Ordered(board, form)};
+    int best{candidates.front()};
+    for (int depth{1}; depth <= board.Size() - static_cast<int>(board.History().size()); ++depth) {
+      int depth_best{-1};
+      int64_t alpha{-kWin - 1};
+      for (const int cell : candidates) {
+        board.Play(cell, form);
+        const int64_t score{-Negamax(board, MnkBoard::Opponent(form), depth - 1, -kWin - 1, -alpha)};
+        board.Undo();
+        if (OutOfTime()) break;
+        if (score > alpha) {
+          alpha = score;
+          depth_best = cell;
+        }
+      }
+      if (OutOfTime()) break;
+      best = depth_best;
+      if (alpha >= kWin - board.Size()) break;
+    }
+    return best;
+  }
+
+  uint64_t NumNodes() const { return nodes_; }
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  bool OutOfTime() {
+    // Reading the clock is cheap but not free, look at it every 256 nodes
+    if ((nodes_ & 255) == 0) out_of_time_ = Clock::now() >= deadline_;
+    return out_of_time_;
+  }
+
+  /**
+   * @brief The candidate cells, best first, at most `kBranching`.
+   */
+  std::vector<int> Ordered(const MnkBoard& board, const Form form) const {
+    std::vector<std::pair<int64_t, int>> scored;
+    for (const int cell : board.Candidates()) scored.push_back({board.MoveGain(cell, form), cell});
+    const size_t count{std::min(kBranching, scored.size())};
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(), std::greater<>());
+    std::vector<int> cells;
+    for (size_t i{0}; i < count; ++i) cells.push_back(scored[i].second);
+    return cells;
+  }
+
+  /**
+   * @brief Whether the form wins by playing fours, each forcing the block.
+   *
+   * @param first Set to the first four of the winning sequence.
+   */
+  bool ContinuousFours(MnkBoard& board, const Form form, const int depth, int& first) {
+    const Form opponent{MnkBoard::Opponent(form)};
+    if (depth == 0 || board.WinningCell(opponent) >= 0) return false;
+    for (const int cell : board.FourCells(form)) {
+      ++nodes_;
+      if (OutOfTime()) return false;
+      board.Play(cell, form);
+      bool wins{false};
+      const int threats{board.NumWinningCells(form)};
+      if (threats >= 2) {
+        wins = true;
+      } else if (threats == 1) {
+        // The opponent has to block, and must not make a four doing so
+        board.Play(board.WinningCell(form), opponent);
+        int next;
+        wins = board.Winner() == nothing && board.WinningCell(opponent) < 0 &&
+               ContinuousFours(board, form, depth - 1, next);
+        board.Undo();
+      }
+      board.Undo();
+      if (wins) {
+        first = cell;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  int64_t Negamax(MnkBoard& board, const Form form, const int depth, int64_t alpha, const int64_t beta) {
+    ++nodes_;
+    const int played{static_cast<int>(board.History().size())};
+    // The previous move won, quicker wins are worth more
+    if (board.Winner() != nothing) return -kWin + played;
+    if (board.IsFull()) return 0;
+    if (board.WinningCell(form) >= 0) return kWin - played - 1;
+    if (depth == 0 || OutOfTime()) return board.Eval(form);
+    std::vector<int> cells;
+    if (const int block{board.WinningCell(MnkBoard::Opponent(form))}; block >= 0) cells.push_back(block);
+    else cells = Ordered(board, form);
+    for (const int cell : cells) {
+      board.Play(cell, form);
+      const int64_t score{-Negamax(board, MnkBoard::Opponent(form), depth - 1, -beta, -alpha)};
+      board.Undo();
+      if (score >= beta) return score;
+      alpha = std::max(alpha, score);
+    }
+    return alpha;
+  }
+
+  std::chrono::milliseconds budget_;
+  Clock::time_point deadline_;
+  uint64_t nodes_{0};
+  bool out_of_time_{false};
+};
+
+#endif // MNK_AI_H
@@ -0,0 +1,222 @@
+#ifndef MNK_BOARD_H
+#define MNK_BOARD_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "tictactoe_rules.h"
+
+/**
+ * @brief The board of an m,n,k game: m rows, n columns, k in a row wins.
+ *
+ * Every run of k cells in a row, column or diagonal is a window, and each
+ * window keeps how many stones of each form it holds. A move only updates the
+ * windows through its cell, and with them the evaluation, the winner and the
+ * windows one or two stones short of a win, so none of those ever rescan the
+ * board.
+ */
+class MnkBoard {
+ public:
+  static constexpr int kMaxSide{26}; // Rows and columns, lettered a to z.
+  static constexpr int kMaxK{12};
+  // Past 8^8 every stone more is worth the same, the evaluation stays far from a win score
+  static constexpr int64_t kMaxWeight{int64_t{1} << 26};
+  static constexpr int64_t kMaxEval{kMaxWeight * 4 * kMaxSide * kMaxSide};
+
+  MnkBoard(const int rows, const int cols, const int k)
+      : rows_(rows), cols_(cols), k_(k), cells_(rows * cols, nothing), near_(rows * cols, 0),
+        cell_windows_(rows * cols), weights_(k + 1, 0) {
+    // A window with one more stone is worth 8 times more
+    for (int c{1}; c <= k; ++c) weights_[c] = c == 1 ? 1 : std::min(weights_[c - 1] * 8, kMaxWeight);
+    const int directions[4][2]{{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    for (const auto& direction : directions) {
+      for (int row{0}; row < rows; ++row) {
+        for (int col{0}; col < cols; ++col) {
+          const int last_row{row + (k - 1) * direction[0]}, last_col{col + (k - 1) * direction[1]};
+          if (last_row >= rows || last_col < 0 || last_col >= cols) continue;
+          std::vector<int> window;
+          for (int i{0}; i < k; ++i) window.push_back((row + i * direction[0]) * cols + col + i * direction[1]);
+          for (const int cell : window) cell_windows_[cell].push_back(static_cast<int>(windows_.size()));
+          windows_.push_back(window);
+        }
+      }
+    }
+    counts_.assign(windows_.size(), {0, 0});
+    for (auto& hot : hot_) hot.assign(windows_.size(), -1);
+  }
+
+  int Rows() const { return rows_; }
+  int Cols() const { return cols_; }
+  int K() const { return k_; }
+  int Size() const { return rows_ * cols_; }
+  Form At(const int cell) const { return cells_[cell]; }
+  Form Winner() const { return winner_; }
+  bool IsFull() const { return static_cast<int>(history_.size()) == Size(); }
+  const std::vector<int>& History() const { return history_; }
+
+  static int Side(const Form form) { return form == circle ? 0 : 1; }
+  static Form Opponent(const Form form) { return form == circle ? cross : circle; }
+
+  void Play(const int cell, const Form form) {
+    const int side{Side(form)};
+    history_.push_back(cell);
+    previous_winners_.push_back(winner_);
+    for (const int window : cell_windows_[cell]) {
+      Contribute(window, -1);
+      if (++counts_[window][side] == k_ && winner_ == nothing) winner_ = form;
+    }
+    cells_[cell] = form;
+    for (const int window : cell_windows_[cell]) Contribute(window, +1);
+    UpdateNear(cell, +1);
+  }
+
+  void Undo() {
+    const int cell{history_.back()};
+    const int side{Side(cells_[cell])};
+    history_.pop_back();
+    for (const int window : cell_windows_[cell]) {
+      Contribute(window, -1);
+      --counts_[window][side];
+    }
+    cells_[cell] = nothing;
+    for (const int window : cell_windows_[cell]) Contribute(window, +1);
+    winner_ = previous_winners_.back();
+    previous_winners_.pop_back();
+    UpdateNear(cell, -1);
+  }
+
+  /**
+   * @brief The static value of the board for a form, from the windows only
+   *        one form has stones in.
+   */
+  int64_t Eval(const Form form) const { return form == circle ? eval_ : -eval_; }
+
+  /**
+   * @brief An empty cell that wins at once for a form, -1 if there is none.
+   */
+  int WinningCell(const Form form) const {
+    const auto& windows = hot_windows_[Side(form)][0];
+    return windows.empty() ? -1 : EmptyCells(windows.front()).front();
+  }
+
+  /**
+   * @brief How many different cells win at once for a form, up to 2.
+   */
+  int NumWinningCells(const Form form) const {
+    int first{-1};
+    for (const int window : hot_windows_[Side(form)][0]) {
+      const int cell{EmptyCells(window).front()};
+      if (first < 0) first = cell;
+      else if (cell != first) return 2;
+    }
+    return first < 0 ? 0 : 1;
+  }
+
+  /**
+   * @brief The empty cells that leave a form one stone short of a win.
+   */
+  std::vector<int> FourCells(const Form form) const {
+    std::vector<int> cells;
+    for (const int window : hot_windows_[Side(form)][1])
+      for (const int cell : EmptyCells(window))
+        if (std::find(cells.begin(), cells.end(), cell) == cells.end()) cells.push_back(cell);
+    return cells;
+  }
+
+  /**
+   * @brief The empty cells at most two cells away from a stone, the center
+   *        of an empty board.
+   */
+  std::vector<int> Candidates() const {
+    std::vector<int> cells;
+    if (history_.empty()) {
+      cells.push_back(rows_ / 2 * cols_ + cols_ / 2);
+      return cells;
+    }
+    for (int cell{0}; cell < Size(); ++cell)
+      if (cells_[cell] == nothing && near_[cell] > 0) cells.push_back(cell);
+    return cells;
+  }
+
+  /**
+   * @brief How much a move of a form is worth, attacking its windows and
+   *        blocking the opponent's, to try the best moves first.
+   */
+  int64_t MoveGain(const int cell, const Form form) const {
+    const int side{Side(form)};
+    int64_t gain{0};
+    for (const int window : cell_windows_[cell]) {
+      const int own{counts_[window][side]}, other{counts_[window][1 - side]};
+      if (other == 0) gain += weights_[own + 1] - weights_[own];
+      if (own == 0) gain += weights_[other + 1] - weights_[other];
+    }
+    return gain;
+  }
+
+ private:
+  /**
+   * @brief Adds (sign +1) or removes (-1) what a window holds to the totals.
+   */
+  void Contribute(const int window, const int sign) {
+    const int circles{counts_[window][0]}, crosses{counts_[window][1]};
+    if (crosses == 0) eval_ += sign * weights_[circles];
+    if (circles == 0) eval_ -= sign * weights_[crosses];
+    for (int side{0}; side < 2; ++side) {
+      const int own{counts_[window][side]}, other{counts_[window][1 - side]};
+      if (other != 0) continue;
+      // Level 0 misses one stone to win, level 1 misses two
+      for (int level{0}; level < 2; ++level) {
+        if (own != k_ - 1 - level || own <= 0) continue;
+        if (sign > 0) Insert(side, level, window);
+        else Erase(side, level, window);
+      }
+    }
+  }
+
+  void Insert(const int side, const int level, const int window) {
+    hot_[side * 2 + level][window] = static_cast<int>(hot_windows_[side][level].size());
+    hot_windows_[side][level].push_back(window);
+  }
+
+  void Erase(const int side, const int level, const int window) {
+    auto& windows = hot_windows_[side][level];
+    auto& positions = hot_[side * 2 + level];
+    const int position{positions[window]};
+    positions[windows.back()] = position;
+    windows[position] = windows.back();
+    windows.pop_back();
+    positions[window] = -1;
+  }
+
+  std::vector<int> EmptyCells(const int window) const {
+    std::vector<int> cells;
+    for (const int cell : windows_[window])
+      if (cells_[cell] == nothing) cells.push_back(cell);
+    return cells;
+  }
+
+  void UpdateNear(const int cell, const int delta) {
+    const int row{cell / cols_}, col{cell % cols_};
+    for (int r{std::max(0, row - 2)}; r <= std::min(rows_ - 1, row + 2); ++r)
+      for (int c{std::max(0, col - 2)}; c <= std::min(cols_ - 1, col + 2); ++c) near_[r * cols_ + c] += delta;
+  }
+
+  int rows_, cols_, k_;
+  std::vector<Form> cells_;
+  std::vector<int> near_;                  // Stones at most two cells away.
+  std::vector<std::vector<int>> windows_;  // The cells of every window.
+  std::vector<std::vector<int>> cell_windows_;
+  std::vector<std::array<int, 2>> counts_; // Circles and crosses of every window.
+  std::vector<int64_t> weights_;
+  int64_t eval_{0};
+  Form winner_{nothing};
+  std::vector<int> history_;
+  std::vector<Form> previous_winners_;
+  // The windows of each form missing one and two stones, with their positions in those lists
+  std::vector<int> hot_windows_[2][2];
+  std::vector<int> hot_[4];
+};
+
+#endif // MNK_BOARD_H
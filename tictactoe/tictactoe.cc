@@ -1,26 +1,26 @@
-#include <limits>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <vector>
-#include "system_func.h"
-#include "random_int_gen.h"
 
-enum Form {
-  nothing = 0,
-  circle = 1,
-  cross = 2
-};
+#include "../common/keyboard.h"
+#include "../common/latency.h"
+#include "../common/random.h"
+#include "../common/terminal.h"
+#include "mnk_ai.h"
+#include "mnk_board.h"
+#include "tictactoe_rules.h"
 
-enum Cell {
-  up_left = 0,
-  up_center = 1,
-  up_right = 2,
-  middle_left = 3,
-  middle_center = 4,
-  middle_right = 5,
-  down_left = 6,
-  down_center = 7,
-  down_right = 8
-};
+// Printed on exit with --stats
+Latency::Metric input_latency{"input"};
+Latency::Metric pc_latency{"pc move"};
+Latency::Metric render_latency{"render"};
+Latency::Metric rules_latency{"win check"};
 
 /**
  * @brief Prints the Tic Tac Toe grid.
@@ -28,6 +28,7 @@ enum Cell {
  * @param grid The grid representing the Tic Tac Toe board, where each element is a pair of a Cell and a Form.
  */
 void PrintGrid(const std::vector<std::pair<Cell, Form>>& grid) {
+  Latency::ScopedTimer timer(render_latency);
   std::cout << '\n';
   for (const auto& cell : grid) {
     if (cell.first != up_left && cell.first != middle_left && cell.first != down_left) {
@@ -44,62 +45,6 @@ void PrintGrid(const std::vector<std::pair<Cell, Form>>& grid) {
   }
 }
 
-/**
- * @brief Checks if three cells have the same form in the given grid.
- *
- * @param a The first cell index.
- * @param b The second cell index.
- * @param c The third cell index.
- * @param grid The grid containing the cells and their forms.
- * @return True if the three cells have the same form, false otherwise.
- */
-bool HasSameForm(Cell a, Cell b, Cell c, const std::vector<std::pair<Cell, Form>>& grid) {
-  return grid[a].second != nothing && grid[a].second == grid[b].second &&
-         grid[b].second == grid[c].second;
-}
-
-/**
- * @brief Checks if the grid is full.
- *
- * @param grid The grid representing the Tic Tac Toe board, where each element is a pair of Cell and Form.
- * @return True if the grid is full, false otherwise.
- */
-bool IsFull(const std::vector<std::pair<Cell, Form>>& grid) {
-  for (const auto& cell : grid) {
-    if (cell.second == nothing) return false;
-  }
-  return true;
-}
-
-/**
- * @brief Check if there is a win condition in the given grid.
- *
- * @param grid The grid representing the game board, where each element is a pair of Cell and Form.
- * @return An integer representing the win condition: 0 for no win, 1 for player 1 win, 2 for player 2 win.
- */
-int CheckWin(const std::vector<std::pair<Cell, Form>>& grid) {
-  // Horizontal wins
-  if (HasSameForm(up_left, up_center, up_right, grid)) 
-    return grid[up_left].second;
-  if (HasSameForm(middle_left, middle_center, middle_right, grid)) 
-    return grid[middle_left].second;
-  if (HasSameForm(down_left, down_center, down_right, grid)) 
-    return grid[down_left].second;
-  // Vertical wins
-  if (HasSameForm(up_left, middle_left, down_left, grid)) 
-    return grid[up_left].second;
-  if (HasSameForm(up_center, middle_center, down_center, grid)) 
-    return grid[up_center].second;
-  if (HasSameForm(up_right, middle_right, down_right, grid)) 
-    return grid[up_right].second;
-  // Diagonal wins
-  if (HasSameForm(up_left, middle_center, down_right, grid)) 
-    return grid[up_left].second;
-  if (HasSameForm(up_right, middle_center, down_left, grid)) 
-    return grid[up_right].second;
-  return nothing;
-}
-
 /**
  * Takes user input and updates the game grid accordingly.
  * 
@@ -107,15 +52,20 @@ int CheckWin(const std::vector<std::pair<Cell, Form>>& grid) {
  * @return True if the user's turn was successful, false otherwise.
  */
 bool UserTurn(std::vector<std::pair<Cell, Form>>& grid) {
-  int user_input;
-  std::cin >> user_input;
+  // The cell is played as soon as its digit is pressed
+  Keyboard::Key key{Latency::Time(input_latency, [] {
+    Keyboard::Key key{Keyboard::input.Read()};
+    while (key.code == Keyboard::enter) key = Keyboard::input.Read();
+    return key;
+  })};
+  if (key.code == Keyboard::end_of_input) std::exit(0);
   Console::ClearScreen();
-  if (std::cin.fail()) {
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  if (key.code != Keyboard::character || !std::isdigit(static_cast<unsigned char>(key.ch))) {
     std::cerr << "Input error, not an integer!" << std::endl;
     return false;
-  } else if (user_input < 0 || user_input > 8) {
+  }
+  const int user_input{key.ch - '0'};
+  if (user_input > 8) {
     std::cout << "This number is not valid, must be between 0 and 8" << std::endl;
     UserTurn(grid);
     return false;
@@ -137,6 +87,7 @@ bool UserTurn(std::vector<std::pair<Cell, Form>>& grid) {
  * @return True if the game turn was successful, false otherwise.
  */
 bool PCTurn(std::vector<std::pair<Cell, Form>>& grid) {
+  Latency::ScopedTimer timer(pc_latency);
   if (IsFull(grid)) return false;
   Cell game_cell_choice{static_cast<Cell>(GetRandomNum(0, 8))};
   while (grid[game_cell_choice].second != nothing) {
@@ -146,7 +97,112 @@ bool PCTurn(std::vector<std::pair<Cell, Form>>& grid) {
   return true;
 }
 
-int main() {
+/**
+ * @brief Reads the flags of the m,n,k mode: `--mnk <rows>,<cols>,<k>`,
+ *        `--gomoku` for 15,15,5 and `--budget <ms>` for the PC's time per move.
+ *
+ * @return True if an m,n,k game was asked for.
+ */
+bool ParseMnk(const int argc, char* argv[], int& rows, int& cols, int& k, int& budget) {
+  bool mnk{false};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--gomoku") == 0) {
+      mnk = true;
+      rows = cols = 15;
+      k = 5;
+    } else if (std::strcmp(argv[i], "--mnk") == 0 && i + 1 < argc) {
+      if (std::sscanf(argv[++i], "%d,%d,%d", &rows, &cols, &k) != 3 || rows < 1 || rows > MnkBoard::kMaxSide ||
+          cols < 1 || cols > MnkBoard::kMaxSide || k < 2 || k > MnkBoard::kMaxK || (k > rows && k > cols)) {
+        std::cerr << "--mnk wants <rows>,<cols>,<k>, at most " << MnkBoard::kMaxSide
+                  << " rows and columns and k at most " << MnkBoard::kMaxK << std::endl;
+        std::exit(1);
+      }
+      mnk = true;
+    } else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+      budget = std::max(1, std::atoi(argv[++i]));
+    }
+  }
+  return mnk;
+}
+
+/**
+ * @brief Prints an m,n,k board, columns lettered and rows numbered.
+ */
+void PrintBoard(const MnkBoard& board) {
+  Latency::ScopedTimer timer(render_latency);
+  std::string text{"\n   "};
+  for (int col{0}; col < board.Cols(); ++col) text += {' ', static_cast<char>('a' + col)};
+  text += '\n';
+  for (int row{0}; row < board.Rows(); ++row) {
+    const std::string number{std::to_string(row + 1)};
+    text += std::string(3 - number.size(), ' ') + number;
+    for (int col{0}; col < board.Cols(); ++col) {
+      const Form form{board.At(row * board.Cols() + col)};
+      text += {' ', form == circle ? 'O' : form == cross ? 'X' : '.'};
+    }
+    text += '\n';
+  }
+  std::cout << text << std::flush;
+}
+
+/**
+ * @brief The cell of a move like `h8`, -1 if it is not an empty cell.
+ */
+int ParseCell(const MnkBoard& board, const std::string& move) {
+  if (move.size() < 2) return -1;
+  const int col{std::tolower(static_cast<unsigned char>(move[0])) - 'a'};
+  for (size_t i{1}; i < move.size(); ++i)
+    if (!std::isdigit(static_cast<unsigned char>(move[i])) || i > 2) return -1;
+  const int row{std::atoi(move.c_str() + 1) - 1};
+  if (col < 0 || col >= board.Cols() || row < 0 || row >= board.Rows()) return -1;
+  const int cell{row * board.Cols() + col};
+  return board.At(cell) == nothing ? cell : -1;
+}
+
+/**
+ * @brief Plays an m,n,k game, the user with O moving first.
+ */
+int PlayMnk(const int rows, const int cols, const int k, const int budget) {
+  MnkBoard board(rows, cols, k);
+  MnkAi ai{std::chrono::milliseconds(budget)};
+  Console::ClearScreen();
+  std::cout << "Welcome to " << k << " in a row on " << rows << 'x' << cols << "!" << std::endl;
+  PrintBoard(board);
+  while (!board.IsFull()) {
+    std::cout << "\nYour move (like " << static_cast<char>('a' + cols / 2) << rows / 2 + 1 << "): " << std::flush;
+    std::string move;
+    if (!Latency::Time(input_latency, [&move] { return Keyboard::input.ReadLine(move); })) return 0;
+    const int cell{ParseCell(board, move)};
+    if (cell < 0) {
+      std::cout << "This is not an empty cell of the board!" << std::endl;
+      continue;
+    }
+    Latency::Time(rules_latency, [&] { board.Play(cell, circle); });
+    Console::ClearScreen();
+    PrintBoard(board);
+    if (board.Winner() == circle) {
+      std::cout << "\nYou won!" << std::endl;
+      return 0;
+    }
+    if (board.IsFull()) break;
+    const int reply{Latency::Time(pc_latency, [&] { return ai.ChooseMove(board, cross); })};
+    Latency::Time(rules_latency, [&] { board.Play(reply, cross); });
+    Console::ClearScreen();
+    PrintBoard(board);
+    std::cout << "\nThe PC played " << static_cast<char>('a' + reply % cols) << reply / cols + 1 << std::endl;
+    if (board.Winner() == cross) {
+      std::cout << "\nYou lost!" << std::endl;
+      return 0;
+    }
+  }
+  std::cout << "\nIt's a tie!" << std::endl;
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  Latency::ParseFlag(argc, argv);
+  if (int rows{3}, cols{3}, k{3}, budget{500}; ParseMnk(argc, argv, rows, cols, k, budget))
+    return PlayMnk(rows, cols, k, budget);
   std::vector<std::pair<Cell, Form>> grid{
   {up_left, nothing},
   {up_center, nothing},
@@ -166,7 +222,7 @@ int main() {
     bool user_chose = UserTurn(grid);
     PrintGrid(grid);
     if (!user_chose) continue;
-    if (CheckWin(grid) == circle) {
+    if (Latency::Time(rules_latency, [&grid] { return CheckWin(grid); }) == circle) {
       std::cout << "\nYou won!" << std::endl;
       return 0;
     }
@@ -174,7 +230,7 @@ int main() {
     Console::ClearScreen();
     PCTurn(grid);
     PrintGrid(grid);
-    if (CheckWin(grid) == cross) {
+    if (Latency::Time(rules_latency, [&grid] { return CheckWin(grid); }) == cross) {
       std::cout << "\nYou lost!" << std::endl;
       return 0;
     }
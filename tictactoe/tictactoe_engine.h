@@ -0,0 +1,80 @@
+#ifndef TICTACTOE_ENGINE_H
+#define TICTACTOE_ENGINE_H
+
+#include <array>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tictactoe_rules.h"
+
+/**
+ * @brief Tic Tac Toe for the headless engine, circle (the user) plays first.
+ */
+struct TicTacToeGame {
+  // The forms in a fixed array, so the state has a fixed size
+  struct State {
+    std::array<Form, 9> cells;
+    int player; // 0 circle, 1 cross.
+  };
+  using Action = int; // The cell, 0 to 8.
+  static constexpr int kNumPlayers{2};
+
+  State Initial(std::mt19937&) const {
+    State state{{}, 0};
+    state.cells.fill(nothing);
+    return state;
+  }
+
+  int CurrentPlayer(const State& state) const { return state.player; }
+
+  void LegalActions(const State& state, std::vector<Action>& actions) const {
+    actions.clear();
+    for (int cell{up_left}; cell <= down_right; ++cell)
+      if (state.cells[cell] == nothing) actions.push_back(cell);
+  }
+
+  State Apply(State state, const Action& cell) const {
+    state.cells[cell] = state.player == 0 ? circle : cross;
+    state.player = 1 - state.player;
+    return state;
+  }
+
+  bool IsTerminal(const State& state) const {
+    if (Winner(state) != nothing) return true;
+    for (const Form form : state.cells)
+      if (form == nothing) return false;
+    return true;
+  }
+
+  double Outcome(const State& state, const int player) const {
+    const int winner{Winner(state)};
+    if (winner == nothing) return 0.5;
+    return winner == (player == 0 ? circle : cross) ? 1 : 0;
+  }
+
+  std::string Render(const State& state) const {
+    std::string text;
+    for (int cell{up_left}; cell <= down_right; ++cell) {
+      text += state.cells[cell] == circle ? 'O' : state.cells[cell] == cross ? 'X' : '.';
+      if (cell % 3 == 2) text += '\n';
+    }
+    return text;
+  }
+
+  std::string ActionName(const Action& cell) const { return std::to_string(cell); }
+
+  bool ParseAction(const std::string& text, Action& cell) const {
+    if (text.size() != 1 || text[0] < '0' || text[0] > '8') return false;
+    cell = text[0] - '0';
+    return true;
+  }
+
+  /**
+   * @brief The form with three in a line, `nothing` if there is none.
+   */
+  static Form Winner(const State& state) { return static_cast<Form>(CheckWin(state.cells)); }
+};
+
+#endif // TICTACTOE_ENGINE_H
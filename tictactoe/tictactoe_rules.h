@@ -0,0 +1,91 @@
+#ifndef TICTACTOE_RULES_H
+#define TICTACTOE_RULES_H
+
+#include <array>
+#include <utility>
+#include <vector>
+
+enum Form {
+  nothing = 0,
+  circle = 1,
+  cross = 2
+};
+
+enum Cell {
+  up_left = 0,
+  up_center = 1,
+  up_right = 2,
+  middle_left = 3,
+  middle_center = 4,
+  middle_right = 5,
+  down_left = 6,
+  down_center = 7,
+  down_right = 8
+};
+
+/**
+ * @brief The form of a cell, in the grid of the game or the fixed array of
+ *        the engine, so both share the rules below.
+ */
+inline Form FormAt(const std::vector<std::pair<Cell, Form>>& grid, const Cell cell) { return grid[cell].second; }
+inline Form FormAt(const std::array<Form, 9>& cells, const Cell cell) { return cells[cell]; }
+
+/**
+ * @brief Checks if three cells have the same form in the given grid.
+ *
+ * @param a The first cell index.
+ * @param b The second cell index.
+ * @param c The third cell index.
+ * @param grid The grid containing the cells and their forms.
+ * @return True if the three cells have the same form, false otherwise.
+ */
+template <typename Grid>
+inline bool HasSameForm(Cell a, Cell b, Cell c, const Grid& grid) {
+  return FormAt(grid, a) != nothing && FormAt(grid, a) == FormAt(grid, b) &&
+         FormAt(grid, b) == FormAt(grid, c);
+}
+
+/**
+ * @brief Checks if the grid is full.
+ *
+ * @param grid The grid representing the Tic Tac Toe board, where each element is a pair of Cell and Form.
+ * @return True if the grid is full, false otherwise.
+ */
+inline bool IsFull(const std::vector<std::pair<Cell, Form>>& grid) {
+  for (const auto& cell : grid) {
+    if (cell.second == nothing) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Check if there is a win condition in the given grid.
+ *
+ * @param grid The grid representing the game board, where each element is a pair of Cell and Form.
+ * @return An integer representing the win condition: 0 for no win, 1 for player 1 win, 2 for player 2 win.
+ */
+template <typename Grid>
+inline int CheckWin(const Grid& grid) {
+  // Horizontal wins
+  if (HasSameForm(up_left, up_center, up_right, grid)) 
+    return FormAt(grid, up_left);
+  if (HasSameForm(middle_left, middle_center, middle_right, grid)) 
+    return FormAt(grid, middle_left);
+  if (HasSameForm(down_left, down_center, down_right, grid)) 
+    return FormAt(grid, down_left);
+  // Vertical wins
+  if (HasSameForm(up_left, middle_left, down_left, grid)) 
+    return FormAt(grid, up_left);
+  if (HasSameForm(up_center, middle_center, down_center, grid)) 
+    return FormAt(grid, up_center);
+  if (HasSameForm(up_right, middle_right, down_right, grid)) 
+    return FormAt(grid, up_right);
+  // Diagonal wins
+  if (HasSameForm(up_left, middle_center, down_right, grid)) 
+    return FormAt(grid, up_left);
+  if (HasSameForm(up_right, middle_center, down_left, grid)) 
+    return FormAt(grid, up_right);
+  return nothing;
+}
+
+#endif // TICTACTOE_RULES_H
@@ -0,0 +1,55 @@
+// Builds the feedback matrix of a Wordle vocabulary ahead of the first game.
+//
+//   build_feedback [--vocab file] [--out file]
+//
+// The colors of every guess against every answer, one byte each, split by
+// guess across the cores. The game builds the matrix itself when it is
+// missing or the vocabulary changed, this only moves that wait out of the
+// first game. Run from wordle/ so the game finds wordle_feedback.bin.
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+int main(int argc, char* argv[]) {
+  std::string vocabulary_file{"wordle_vocab.txt"}, out_file{"wordle_feedback.bin"};
+  for (int i{1}; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--vocab") == 0 && i + 1 < argc) vocabulary_file = argv[++i];
+    else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_file = argv[++i];
+  }
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::string> words{Feedback::ReadVocabulary(vocabulary_file)};
+  if (words.empty()) {
+    std::cerr << "Could not read " << vocabulary_file << ", or its words are longer than " << Feedback::kMaxLength
+              << " letters" << std::endl;
+    return 1;
+  }
+  if (!Feedback::Build(words, out_file)) {
+    std::cerr << "Could not write " << out_file << std::endl;
+    return 1;
+  }
+  const double seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  Feedback::Matrix matrix;
+  if (!matrix.Load(words, out_file)) {
+    std::cerr << "Could not map " << out_file << std::endl;
+    return 1;
+  }
+  // Every pair read back must give what the rules give
+  const std::vector<std::string>& vocabulary{matrix.Words()};
+  for (size_t guess{0}; guess < vocabulary.size(); ++guess) {
+    for (size_t answer{0}; answer < vocabulary.size(); ++answer) {
+      if (Feedback::Decode(matrix.Code(guess, answer), vocabulary[guess].length()) !=
+          CheckColors(vocabulary[answer], vocabulary[guess])) {
+        std::cerr << "Wrong colors for " << vocabulary[guess] << " against " << vocabulary[answer] << std::endl;
+        return 1;
+      }
+    }
+  }
+  std::cout << vocabulary.size() << " x " << vocabulary.size() << " colors written to " << out_file << " in "
+            << seconds << " s" << std::endl;
+}
@@ -6,6 +6,8 @@
 
 #include <ostream>
 
+#include "../common/styled_text.h"
+
 namespace Color {
   enum Code {
     FG_RED      = 31, // Red foreground color code
@@ -30,6 +32,10 @@ namespace Color {
     friend std::ostream& operator<<(std::ostream& os, const Modifier& mod) {
       return os << "\033[" << mod.code_ << "m";
     }
+    // On styled text the color is only written if the text needs it
+    friend Styled::Text& operator<<(Styled::Text& text, const Modifier& mod) {
+      return text.Apply(mod.code_);
+    }
    private:
     Code code_;
   };
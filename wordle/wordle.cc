@@ -1,143 +1,161 @@
 #include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <random>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "../common/keyboard.h"
+#include "../common/latency.h"
+#include "../common/stats_store.h"
+#include "../common/styled_text.h"
+#include "../common/terminal.h"
+#include "../common/word_file.h"
 #include "colormod.h"
+#include "wordle_absurdle.h"
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
 
-std::mt19937 generator(std::random_device{}());
-
-int GetRandomNum(const int min, const int max) {
-  std::uniform_int_distribution<int> distribution(min, max);
-  return distribution(generator);
-}
-
-int GetNumLinesFromFile(const std::string& input_file_name) {
-    std::ifstream input_file(input_file_name); 
-    if (!input_file.is_open()) return 0;
-    return std::count(std::istreambuf_iterator<char>(input_file),
-                      std::istreambuf_iterator<char>(), '\n');
-}
-
-std::string RandomWordFromFile(const std::string& input_file_name) {
-  std::ifstream input_file(input_file_name); 
-  if (!input_file.is_open()) return "";
-  const int num_lines{GetNumLinesFromFile(input_file_name)};
-  int target_line{GetRandomNum(0, num_lines)}, currentLine{0};
-  std::string line;
-  while (std::getline(input_file, line))
-    if (++currentLine == target_line) break;
-  std::istringstream line_stream(line);
-  std::string word;
-  line_stream >> word;
-  input_file.close();
-  return word;
-}
+// Printed on exit with --stats
+Latency::Metric input_latency{"input"};
+Latency::Metric feedback_latency{"feedback"};
+Latency::Metric render_latency{"render"};
+Latency::Metric word_file_latency{"word file"};
+Latency::Metric matrix_latency{"feedback matrix"};
 
 void PrintGame(const std::string& word, const std::string& letters_tried,
                const std::vector<std::pair<std::string, std::string>>& words_tried) {
+  Latency::ScopedTimer timer(render_latency);
+  // The whole screen is gathered first and written at once
+  Styled::Text text;
   // Print used letters
-  std::cout << "Intentos disponibles: " << 6 - words_tried.size() << "\n\n";
-  std::cout << "Letras utilizadas: ";
-  for (size_t i = 0; !letters_tried.empty() && i < letters_tried.length() - 1; ++i)
-    std::cout << letters_tried[i] << ", ";
-  std::cout << letters_tried[letters_tried.length() - 1] << "\n\n";
+  text << "Intentos disponibles: " << 6 - words_tried.size() << "\n\n";
+  text << "Letras utilizadas: ";
+  for (size_t i = 0; i < letters_tried.length(); ++i)
+    text << (i == 0 ? "" : ", ") << letters_tried[i];
+  text << "\n\n";
   // Print words tried
   Color::Modifier green(Color::FG_GREEN);
   Color::Modifier yellow(Color::FG_YELLOW);
   Color::Modifier def(Color::FG_DEFAULT);
   for (const auto& guess : words_tried) {
-    std::cout << "        ";
+    text << "        ";
     for (size_t i = 0; i < guess.first.length(); ++i) {
       if (guess.second[i] == 'G')
-        std::cout << green << guess.first[i] << def;
+        text << green << guess.first[i] << def;
       else if (guess.second[i] == 'Y') 
-        std::cout << yellow << guess.first[i] << def;
+        text << yellow << guess.first[i] << def;
       else
-        std::cout << guess.first[i];
-      std::cout << " ";
+        text << guess.first[i];
+      text << " ";
     }
-    std::cout << std::endl;
+    text << "\n";
   }
+  text.Flush();
 }
 
-std::string CheckColors(const std::string& og_word, const std::string& guess) {
-  std::string word{og_word};
-  std::string guess_color(guess.length(), 'W');
-  // Check for correct positions
-  for (size_t i = 0; i < guess.length(); ++i) {
-    if (guess[i] == word[i]) {
-      guess_color[i] = 'G';
-      word[i] = '_'; // Mark this letter as used
-    }
-  }
-  // Check for correct letters in wrong positions
-  for (size_t i = 0; i < guess.length(); ++i) {
-    if (guess_color[i] == 'G') continue; // Skip already correctly guessed letters
-    auto index = std::find(word.begin(), word.end(), guess[i]);
-    if (index != word.end()) {
-      guess_color[i] = 'Y';
-      *index = '_'; // Mark this letter as used
-    }
-  }
-  return guess_color;
-}
-
-bool GameRound(int& num_attemps, const std::string& word, std::string& letters_tried, 
-               std::vector<std::pair<std::string, std::string>>& words_tried) {
+/**
+ * @brief Reads a guess and adds it with its colors to the words tried.
+ *
+ * @param answer Gives the colors of a guess.
+ * @return True if every letter of the guess is in its place.
+ */
+bool GameRound(int& num_attemps, const size_t word_length, std::string& letters_tried,
+               std::vector<std::pair<std::string, std::string>>& words_tried,
+               const std::function<std::string(const std::string&)>& answer) {
   // Ask user guessed word
   std::cout << "        ";
   std::string guess;
-  std::cin >> guess;
-  system("clear");
+  if (!Latency::Time(input_latency, [&guess] { return Keyboard::input.ReadLine(guess); })) exit(EXIT_SUCCESS);
+  Console::ClearScreen();
   // Upper the guess word because the word is in uppercase
   for (char& c : guess) c = toupper(c);
-  if (guess.length() != word.length()) {
+  if (guess.length() != word_length) {
     std::cout << "Invalid word, must be a five letter word!" << std::endl;
     num_attemps++;
     return false;
   }
   // Save the word in words_tried
-  words_tried.push_back(std::make_pair(guess, CheckColors(word, guess)));
+  const std::string colors{Latency::Time(feedback_latency, [&] { return answer(guess); })};
+  words_tried.push_back(std::make_pair(guess, colors));
   // Save letters used in letters_tried
   for (size_t i{0}; i < guess.length(); ++i)
     if (std::find(letters_tried.begin(), letters_tried.end(), guess[i]) == letters_tried.end())
       letters_tried += guess[i];
-  return guess == word;
+  return colors == std::string(word_length, 'G');
 }
 
 const bool win{true};
 
-bool Game(const std::string& vocabulary_file_name, int num_attemps) {
-  system("clear");
-  // Get the word from the file
-  std::string word = RandomWordFromFile(vocabulary_file_name);
+/**
+ * @brief Plays a game.
+ *
+ * @param absurdle Whether no word is chosen and every guess keeps as many
+ *        words of the vocabulary possible as it can.
+ */
+bool Game(const std::string& vocabulary_file_name, const std::string& feedback_file_name, int num_attemps,
+          const bool absurdle) {
+  Console::ClearScreen();
+  // Mapped, or built first if the vocabulary changed; without it the colors are computed
+  Feedback::Matrix matrix;
+  Latency::Time(matrix_latency, [&] { return matrix.Open(vocabulary_file_name, feedback_file_name); });
+  std::string word;
+  std::vector<std::string> vocabulary;
+  if (absurdle) {
+    vocabulary = Latency::Time(word_file_latency, [&] { return Feedback::ReadVocabulary(vocabulary_file_name); });
+    if (vocabulary.empty()) {
+      std::cerr << "Absurdle needs a vocabulary of words of at most " << Feedback::kMaxLength << " letters\n";
+      exit(EXIT_FAILURE);
+    }
+    word = vocabulary.front();
+  } else {
+    // Get the word from the file
+    word = Latency::Time(word_file_latency, [&] { return RandomWordFromFile(vocabulary_file_name); });
+  }
   if (word.empty()) {
     std::cerr << "There was an error trying to get the word\n";
     exit(EXIT_FAILURE);
   }
   for (char& c : word) c = toupper(c);
-  std::string guess_word(word.length(), '_');
+  Absurdle adversary(vocabulary, matrix);
+  std::function<std::string(const std::string&)> answer;
+  // The answer is looked up once, each guess then costs one lookup and one read of the matrix
+  const int word_index{matrix.Index(word)};
+  if (absurdle) answer = [&adversary](const std::string& guess) { return adversary.Guess(guess); };
+  else answer = [&matrix, &word, word_index](const std::string& guess) {
+    return matrix.Colors(word, word_index, guess);
+  };
   std::string letters_tried;
   std::vector<std::pair<std::string, std::string>> words_tried{};
   bool status{false};
   PrintGame(word, letters_tried, words_tried);
   while (num_attemps--) {
-    status = GameRound(num_attemps, word, letters_tried, words_tried);
+    status = GameRound(num_attemps, word.length(), letters_tried, words_tried, answer);
     PrintGame(word, letters_tried, words_tried);
     if (status == win) return win;
   }
+  if (absurdle) {
+    std::cout << "\n" << adversary.NumCandidates() << " words were still possible, like "
+              << adversary.Candidate(0) << "\n\n";
+  }
   return !win;
 }
 
 // This program only works on Linux
-int main() {
+int main(int argc, char* argv[]) {
+  Latency::ParseFlag(argc, argv);
   const int num_attemps{6};
   const std::string vocabulary_file_name{"wordle_vocab.txt"};
-  std::cout << (Game(vocabulary_file_name, num_attemps) ? 
-  "Congratulations!!!" : "Better luck next time...");
+  const std::string feedback_file_name{"wordle_feedback.bin"};
+  // --absurdle: the game picks no word and dodges every guess it can
+  bool absurdle{false};
+  for (int i{1}; i < argc; ++i) absurdle = absurdle || std::strcmp(argv[i], "--absurdle") == 0;
+  const bool won{Game(vocabulary_file_name, feedback_file_name, num_attemps, absurdle) == win};
+  std::cout << (won ? "Congratulations!!!" : "Better luck next time...");
   std::cout << std::endl;
+  // Absurdle results would skew the Wordle standings
+  if (!absurdle) Stats::RecordResult(Stats::Game::wordle, won ? Stats::Outcome::win : Stats::Outcome::loss);
 }
\ No newline at end of file
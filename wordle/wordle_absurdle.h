@@ -0,0 +1,78 @@
+#ifndef WORDLE_ABSURDLE_H
+#define WORDLE_ABSURDLE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "wordle_feedback.h"
+#include "wordle_rules.h"
+
+/**
+ * @brief Wordle where the answer is never chosen: every guess gets the colors
+ *        that leave the most words of the vocabulary still possible.
+ *
+ * The words still possible are positions in the vocabulary, kept at the
+ * front of one array. A guess computes the colors of every one of them,
+ * counts them per color code (there are 3^5 = 243 codes), keeps the largest
+ * group and moves it to the front of the array in place. Each guess is one
+ * pass over the words left, with no allocation.
+ */
+class Absurdle {
+ public:
+  static constexpr int kNumCodes{Feedback::kNumCodes};
+
+  /**
+   * @param words Words of at most `Feedback::kMaxLength` letters, as
+   *        `Feedback::ReadVocabulary` gives them.
+   * @param matrix The colors of the vocabulary, used when loaded.
+   */
+  Absurdle(const std::vector<std::string>& words, const Feedback::Matrix& matrix)
+      : words_(words), matrix_(matrix), candidates_(words.size()), codes_(words.size()) {
+    for (size_t i{0}; i < words.size(); ++i) candidates_[i] = static_cast<uint32_t>(i);
+    num_candidates_ = words.size();
+  }
+
+  size_t NumCandidates() const { return num_candidates_; }
+
+  // A word still possible, the answer once only one is left
+  const std::string& Candidate(const size_t i) const { return words_[candidates_[i]]; }
+
+  /**
+   * @brief Answers a guess as long as the words, keeping the words that share
+   *        the most common colors, every code below `kNumCodes`.
+   *
+   * Among groups of the same size the lowest code wins, the one with the
+   * fewest greens and yellows on the first letters.
+   *
+   * @return The colors of the guess, as `CheckColors` gives them.
+   */
+  std::string Guess(const std::string& guess) {
+    const int guess_index{matrix_.IsLoaded() ? matrix_.Index(guess) : -1};
+    uint32_t counts[kNumCodes]{};
+    for (size_t i{0}; i < num_candidates_; ++i) {
+      const uint32_t answer{candidates_[i]};
+      codes_[i] = guess_index >= 0 ? matrix_.Code(guess_index, answer)
+                                   : Feedback::Encode(CheckColors(words_[answer], guess));
+      ++counts[codes_[i]];
+    }
+    int best{0};
+    for (int code{1}; code < kNumCodes; ++code)
+      if (counts[code] > counts[best]) best = code;
+    // The kept words move to the front, in their order
+    size_t kept{0};
+    for (size_t i{0}; i < num_candidates_; ++i)
+      if (codes_[i] == best) candidates_[kept++] = candidates_[i];
+    num_candidates_ = kept;
+    return Feedback::Decode(best, guess.length());
+  }
+
+ private:
+  const std::vector<std::string>& words_;
+  const Feedback::Matrix& matrix_;
+  std::vector<uint32_t> candidates_;
+  std::vector<uint8_t> codes_; // The code of each candidate for the guess being answered.
+  size_t num_candidates_;
+};
+
+#endif // WORDLE_ABSURDLE_H
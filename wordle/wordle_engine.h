@@ -0,0 +1,107 @@
+#ifndef WORDLE_ENGINE_H
+#define WORDLE_ENGINE_H
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/engine.h"
+#include "wordle_rules.h"
+
+/**
+ * @brief Wordle for the headless engine, a single player guesses words of the vocabulary.
+ */
+class WordleGame {
+ public:
+  struct State {
+    int word;                                       // The index of the word to guess.
+    std::vector<std::pair<int, std::string>> tried; // Every guess with its colors.
+  };
+  using Action = int; // The index of the guessed word.
+  static constexpr int kNumPlayers{1};
+  static constexpr int kNumAttempts{6};
+
+  explicit WordleGame(std::vector<std::string> words) : words_(std::move(words)) {
+    for (auto& word : words_)
+      for (auto& c : word) c = toupper(c);
+  }
+
+  const std::vector<std::string>& Words() const { return words_; }
+
+  State Initial(std::mt19937& generator) const {
+    return {std::uniform_int_distribution<int>(0, static_cast<int>(words_.size()) - 1)(generator), {}};
+  }
+
+  int CurrentPlayer(const State&) const { return 0; }
+
+  void LegalActions(const State&, std::vector<Action>& actions) const {
+    actions.resize(words_.size());
+    for (size_t i{0}; i < words_.size(); ++i) actions[i] = static_cast<int>(i);
+  }
+
+  State Apply(State state, const Action& guess) const {
+    state.tried.push_back({guess, CheckColors(words_[state.word], words_[guess])});
+    return state;
+  }
+
+  bool IsTerminal(const State& state) const {
+    return Solved(state) || static_cast<int>(state.tried.size()) >= kNumAttempts;
+  }
+
+  double Outcome(const State& state, int) const { return Solved(state) ? 1 : 0; }
+
+  std::string Render(const State& state) const {
+    std::string text;
+    for (const auto& [guess, colors] : state.tried) text += words_[guess] + " " + colors + "\n";
+    return text;
+  }
+
+  std::string ActionName(const Action& guess) const { return words_[guess]; }
+
+  bool ParseAction(const std::string& text, Action& guess) const {
+    std::string word{text};
+    for (auto& c : word) c = toupper(c);
+    for (size_t i{0}; i < words_.size(); ++i) {
+      if (words_[i] == word) {
+        guess = static_cast<int>(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  static bool Solved(const State& state) { return !state.tried.empty() && state.tried.back().first == state.word; }
+
+  std::vector<std::string> words_;
+};
+
+/**
+ * @brief Guesses a random word that gives the same colors to every guess so far.
+ */
+class ConsistentWordAgent : public Engine::Agent<WordleGame> {
+ public:
+  int Act(const WordleGame& game, const WordleGame::State& state, std::mt19937& generator) override {
+    const std::vector<std::string>& words = game.Words();
+    candidates_.clear();
+    for (size_t i{0}; i < words.size(); ++i) {
+      bool fits{true};
+      for (const auto& [guess, colors] : state.tried) {
+        if (CheckColors(words[i], words[guess]) != colors) {
+          fits = false;
+          break;
+        }
+      }
+      if (fits) candidates_.push_back(static_cast<int>(i));
+    }
+    if (candidates_.empty()) return std::uniform_int_distribution<int>(0, static_cast<int>(words.size()) - 1)(generator);
+    return candidates_[std::uniform_int_distribution<size_t>(0, candidates_.size() - 1)(generator)];
+  }
+
+ private:
+  std::vector<int> candidates_;
+};
+
+#endif // WORDLE_ENGINE_H
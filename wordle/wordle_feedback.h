@@ -0,0 +1,216 @@
+#ifndef WORDLE_FEEDBACK_H
+#define WORDLE_FEEDBACK_H
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common/parallel.h"
+#include "../common/word_file.h"
+#include "wordle_rules.h"
+
+/**
+ * The colors of every guess against every answer of a vocabulary, computed
+ * once and kept in a file of one byte per pair, the colors in base 3.
+ *
+ * The header holds a hash of the vocabulary, so a file built for another
+ * vocabulary is never used: `Matrix::Open` builds it again instead. The file
+ * is mapped, so looking the colors up is a single read of memory.
+ */
+namespace Feedback {
+  const uint64_t kMagic{0x314b42464c445257}; // "WRDLFBK1"
+  const size_t kMaxWords{8192};              // 64 MB of matrix, larger vocabularies compute the colors.
+  const size_t kMaxLength{5};                // The colors of longer words don't fit in a byte.
+  const int kNumCodes{243};                  // 3^kMaxLength.
+
+  struct Header {
+    uint64_t magic;
+    uint32_t word_length;
+    uint32_t num_words;
+    uint64_t vocabulary_hash;
+  };
+
+  /**
+   * @brief The colors of `CheckColors` as a number below 3^length, the first
+   *        letter the most significant digit: 'W' 0, 'Y' 1 and 'G' 2.
+   *
+   * The colors are at most `kMaxLength` long, so the number is below `kNumCodes`.
+   */
+  inline uint8_t Encode(const std::string& colors) {
+    unsigned code{0};
+    for (const char color : colors) code = code * 3 + (color == 'G' ? 2 : color == 'Y' ? 1 : 0);
+    return static_cast<uint8_t>(code);
+  }
+
+  inline std::string Decode(unsigned code, const size_t length) {
+    std::string colors(length, 'W');
+    for (size_t i{length}; i-- > 0; code /= 3) colors[i] = "WYG"[code % 3];
+    return colors;
+  }
+
+  // FNV-1a of the words, one per line
+  inline uint64_t HashWords(const std::vector<std::string>& words) {
+    uint64_t hash{14695981039346656037ULL};
+    for (const std::string& word : words) {
+      for (const char c : word + '\n') hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief The words of a vocabulary file in uppercase, the ones with the
+   *        length of the first word.
+   *
+   * @return The words, none if the file cannot be read or its first word is
+   *         longer than `kMaxLength`.
+   */
+  inline std::vector<std::string> ReadVocabulary(const std::string& file_name) {
+    std::vector<std::string> words;
+    for (std::string word : ReadWordsFromFile(file_name)) {
+      for (char& c : word) c = std::toupper(static_cast<unsigned char>(c));
+      if (words.empty() || word.length() == words.front().length()) words.push_back(word);
+    }
+    if (!words.empty() && words.front().length() > kMaxLength) return {};
+    return words;
+  }
+
+  // Every thread writes its own rows of the matrix, there is nothing to merge
+  struct Rows {
+    void Merge(const Rows&) {}
+  };
+
+  /**
+   * @brief Computes the colors of every pair of words, splitting the guesses
+   *        across the cores, and writes the matrix file.
+   *
+   * The file is written under another name and renamed, so a game starting
+   * meanwhile never maps half a file.
+   *
+   * @return True on success, false if the file could not be written.
+   */
+  inline bool Build(const std::vector<std::string>& words, const std::string& file_name) {
+    const size_t num_words{words.size()};
+    if (num_words == 0 || words.front().length() > kMaxLength) return false;
+    std::vector<uint8_t> codes(num_words * num_words);
+    Parallel::Accumulate<Rows>(num_words, [&](Rows&, const uint64_t begin, const uint64_t end, unsigned) {
+      for (uint64_t guess{begin}; guess < end; ++guess)
+        for (size_t answer{0}; answer < num_words; ++answer)
+          codes[guess * num_words + answer] = Encode(CheckColors(words[answer], words[guess]));
+    });
+    const Header header{kMagic, static_cast<uint32_t>(words.front().length()), static_cast<uint32_t>(num_words),
+                        HashWords(words)};
+    const std::string temporary_name{file_name + ".tmp"};
+    {
+      std::ofstream file(temporary_name, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(codes.data()), codes.size());
+      if (!file) return false;
+    }
+    return std::rename(temporary_name.c_str(), file_name.c_str()) == 0;
+  }
+
+  class Matrix {
+   public:
+    Matrix() = default;
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+
+    ~Matrix() {
+      if (data_) munmap(data_, size_);
+    }
+
+    /**
+     * @brief Maps the matrix of a vocabulary, building it first if the file
+     *        is missing or was built for other words.
+     *
+     * @return True on success, false if the vocabulary cannot be read, has
+     *         more than `kMaxWords` words or the matrix cannot be written.
+     */
+    bool Open(const std::string& vocabulary_file_name, const std::string& file_name) {
+      std::vector<std::string> words{ReadVocabulary(vocabulary_file_name)};
+      if (words.empty() || words.size() > kMaxWords) return false;
+      if (Load(words, file_name)) return true;
+      if (!Build(words, file_name)) {
+        std::cerr << "Could not write " << file_name << std::endl;
+        return false;
+      }
+      return Load(words, file_name);
+    }
+
+    /**
+     * @brief Maps a matrix file if it was built for exactly these words.
+     */
+    bool Load(std::vector<std::string>& words, const std::string& file_name) {
+      const int fd{open(file_name.c_str(), O_RDONLY | O_CLOEXEC)};
+      if (fd < 0) return false;
+      struct stat file_stat;
+      void* data{MAP_FAILED};
+      if (fstat(fd, &file_stat) == 0 && file_stat.st_size >= static_cast<off_t>(sizeof(Header)))
+        data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED) return false;
+      const Header* header{static_cast<const Header*>(data)};
+      if (header->magic != kMagic || words.front().length() > kMaxLength ||
+          header->word_length != words.front().length() || header->num_words != words.size() ||
+          header->vocabulary_hash != HashWords(words) ||
+          static_cast<uint64_t>(file_stat.st_size) != sizeof(Header) + words.size() * words.size()) {
+        munmap(data, file_stat.st_size);
+        return false;
+      }
+      if (data_) munmap(data_, size_);
+      data_ = data;
+      size_ = file_stat.st_size;
+      codes_ = reinterpret_cast<const uint8_t*>(header + 1);
+      words_.swap(words);
+      index_.clear();
+      for (size_t i{0}; i < words_.size(); ++i) index_.emplace(words_[i], static_cast<int>(i));
+      return true;
+    }
+
+    bool IsLoaded() const { return data_ != nullptr; }
+    const std::vector<std::string>& Words() const { return words_; }
+
+    /**
+     * @brief The position of a word in the vocabulary, -1 if it is not there.
+     */
+    int Index(const std::string& word) const {
+      const auto found = index_.find(word);
+      return found == index_.end() ? -1 : found->second;
+    }
+
+    // The colors of a guess against an answer, both positions in the vocabulary
+    uint8_t Code(const int guess, const int answer) const { return codes_[guess * words_.size() + answer]; }
+
+    /**
+     * @brief The colors of a guess, from the matrix when both words are in
+     *        the vocabulary.
+     *
+     * @param answer_index The position of the answer, looked up once per game
+     *        with `Index`.
+     */
+    std::string Colors(const std::string& answer, const int answer_index, const std::string& guess) const {
+      const int guess_index{answer_index < 0 ? -1 : Index(guess)};
+      if (guess_index < 0) return CheckColors(answer, guess);
+      return Decode(Code(guess_index, answer_index), guess.length());
+    }
+
+   private:
+    void* data_{nullptr};
+    size_t size_{0};
+    const uint8_t* codes_{nullptr};
+    std::vector<std::string> words_;
+    std::unordered_map<std::string, int> index_;
+  };
+}
+
+#endif // WORDLE_FEEDBACK_H
@@ -0,0 +1,37 @@
+#ifndef WORDLE_RULES_H
+#define WORDLE_RULES_H
+
+#include <algorithm>
+#include <string>
+
+/**
+ * @brief The colors of a guess: 'G' for a letter in its place, 'Y' for a
+ *        letter of the word in another place and 'W' for the rest.
+ *
+ * @param og_word The word to guess.
+ * @param guess The guess, as long as the word.
+ * @return One color per letter of the guess.
+ */
+inline std::string CheckColors(const std::string& og_word, const std::string& guess) {
+  std::string word{og_word};
+  std::string guess_color(guess.length(), 'W');
+  // Check for correct positions
+  for (size_t i = 0; i < guess.length(); ++i) {
+    if (guess[i] == word[i]) {
+      guess_color[i] = 'G';
+      word[i] = '_'; // Mark this letter as used
+    }
+  }
+  // Check for correct letters in wrong positions
+  for (size_t i = 0; i < guess.length(); ++i) {
+    if (guess_color[i] == 'G') continue; // Skip already correctly guessed letters
+    auto index = std::find(word.begin(), word.end(), guess[i]);
+    if (index != word.end()) {
+      guess_color[i] = 'Y';
+      *index = '_'; // Mark this letter as used
+    }
+  }
+  return guess_color;
+}
+
+#endif // WORDLE_RULES_H